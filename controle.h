@@ -0,0 +1,83 @@
+// ══════════════════════════════════════════════════════════
+//  LÓGICA DE CONTROLE – histérese e proteção dos relés
+//  Sem dependências do Arduino: o firmware (controlar()) e as
+//  ferramentas de host em tools/ usam exatamente o mesmo código.
+// ══════════════════════════════════════════════════════════
+#pragma once
+#include <stdint.h>
+
+struct Limiares { float tempLigar, tempDeslig, umidLigar, umidDeslig; int luzLigar, luzDeslig; };
+
+/** Atualiza lampada/motor a partir de uma leitura (estado anterior entra e sai) */
+inline void decidirReles(const Limiares& c, float temp, float umid, int luz,
+                         bool& lampada, bool& motor) {
+    // Motor – liga por temperatura OU umidade (histérese dupla)
+    if (!motor  && (temp > c.tempLigar  || umid > c.umidLigar ))  motor  = true;
+    if ( motor  && (temp < c.tempDeslig && umid < c.umidDeslig))  motor  = false;
+
+    // Lâmpada – liga quando ambiente escuro
+    if (!lampada && luz < c.luzLigar )  lampada = true;
+    if ( lampada && luz > c.luzDeslig)  lampada = false;
+}
+
+// ──────────────────────────────────────────────────────────
+//  PROTEÇÃO DOS RELÉS – a histérese diz o que se quer; aqui se
+//  decide quando a troca pode acontecer: tempo mínimo em cada
+//  estado e teto de trocas numa janela móvel de 1 h.
+// ──────────────────────────────────────────────────────────
+#define RELE_JANELA_MAX  16   // trocas lembradas (teto para maxPorHora)
+
+struct LimiteRele { uint32_t minLigadoS, minDesligS; uint8_t maxPorHora; };   // 0 = sem limite
+
+// Padrões do firmware; tools/planta.h parte dos mesmos valores
+#define LAMP_MIN_LIGADA_S      60   // reator da lâmpada não gosta de piscar com nuvens
+#define LAMP_MIN_DESLIG_S      60
+#define LAMP_MAX_POR_HORA      12
+#define MOTOR_MIN_LIGADO_S    120   // corrente de partida aquece o enrolamento
+#define MOTOR_MIN_DESLIG_S     60   // e o rotor precisa parar antes de religar
+#define MOTOR_MAX_POR_HORA      6
+static_assert(LAMP_MAX_POR_HORA <= RELE_JANELA_MAX && MOTOR_MAX_POR_HORA <= RELE_JANELA_MAX,
+              "aumente RELE_JANELA_MAX");
+
+struct EstadoRele {
+    bool     ligado;                    // estado aplicado ao relé
+    bool     pendente;                  // há um pedido de troca sendo segurado
+    uint8_t  nTrocas, proxima;          // anel de trocas
+    uint32_t desde;                     // instante (s) da última troca
+    uint32_t trocas[RELE_JANELA_MAX];   // instantes das últimas trocas
+    uint32_t suprimidos;                // pedidos segurados (um por episódio)
+};
+
+/** Trocas feitas nos últimos 3600 s */
+inline uint8_t releTrocasHora(const EstadoRele& r, uint32_t t) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < r.nTrocas; i++) n += t - r.trocas[i] < 3600;
+    return n;
+}
+
+/**
+ * Tenta levar o relé a 'desejado' no instante t (s). Devolve true só
+ * se o estado aplicado mudou – é o único caso em que o GPIO é escrito.
+ * Um pedido segurado continua valendo: aplica-se assim que os limites
+ * deixarem, se ainda for o desejado.
+ */
+inline bool releAplicar(EstadoRele& r, const LimiteRele& lim, bool desejado, uint32_t t) {
+    if (desejado == r.ligado) { r.pendente = false; return false; }
+
+    uint32_t minimo = r.ligado ? lim.minLigadoS : lim.minDesligS;
+    bool     livre  = t - r.desde >= minimo &&
+                      (lim.maxPorHora == 0 || releTrocasHora(r, t) < lim.maxPorHora);
+    if (!livre) {
+        if (!r.pendente) r.suprimidos++;
+        r.pendente = true;
+        return false;
+    }
+
+    r.ligado   = desejado;
+    r.pendente = false;
+    r.desde    = t;
+    r.trocas[r.proxima] = t;
+    r.proxima  = (r.proxima + 1) % RELE_JANELA_MAX;
+    if (r.nTrocas < RELE_JANELA_MAX) r.nTrocas++;
+    return true;
+}
@@ -23,10 +23,10 @@
  *   MAPEAMENTO DE PINOS (ESP32)
  *   ─────────────────────────────────────────
  *   DHT22  dados      → GPIO  4
- *   LDR    ADC        → GPIO 34  (ADC1_CH0)
+ *   LDR    ADC        → GPIO 34  (ADC1_CH6, amostrado via I2S/DMA)
  *   Relé Canal 1      → GPIO  2  (Lâmpada Grow)
  *   Relé Canal 2      → GPIO 15  (Motor / Ventilador)
- *   LCD I2C           → SDA GPIO 21 | SCL GPIO 22 (padrão ESP32)
+ *   LCD I2C           → SDA GPIO 21 | SCL GPIO 22 (100 kHz)
  *
  *   CIRCUITO DO LDR (divisor de tensão)
  *   ─────────────────────────────────────────
@@ -62,21 +62,56 @@
  *     Cada relé pode ser ligado / desligado individualmente
  *     pela interface web; a lógica automática fica suspensa.
  *
+ *   PROTEÇÃO DOS RELÉS (nos dois modos)
+ *   ─────────────────────────────────────────
+ *     Tempo mínimo ligado / desligado e máximo de trocas por
+ *     hora por canal. Uma troca pedida antes da hora fica
+ *     pendente e é contada em "suprimidos" (/api/data); o GPIO
+ *     só é escrito quando o estado realmente muda.
+ *
+ *   TAREFAS (FreeRTOS)
+ *   ─────────────────────────────────────────
+ *     Núcleo 1 : controle (prio 4) > agenda/sensores (3) > filtro LDR (2)
+ *                > display/log (1)
+ *     Núcleo 0 : pilha WiFi + servidor web / SSE (1)
+ *     Só a tarefa de controle altera o estado; sensores e web
+ *     enviam pedidos pela fila filaControle, então nenhuma
+ *     decisão de relé espera por HTTP ou pelo LCD.
+ *     Nada roda "a cada volta": a agenda dorme até o próximo
+ *     prazo, o controle até chegar mensagem e o LCD até o
+ *     estado publicado mudar – e só redesenha se o que a tela
+ *     atual mostra mudou.
+ *
  *   BIBLIOTECAS NECESSÁRIAS (Library Manager)
  *   ─────────────────────────────────────────
- *     • DHT sensor library        (Adafruit)
- *     • Adafruit Unified Sensor
- *     • LiquidCrystal_I2C         (Frank de Castelbajac)
- *     • WiFi.h / WebServer.h      (já incluídas no core ESP32)
+ *     • WiFi.h / WebServer.h / Wire.h (já incluídas no core ESP32)
+ *     • LittleFS.h                (já incluída no core ESP32; usa a
+ *                                  partição "spiffs" do esquema padrão)
+ *     O DHT22 é lido pelo periférico RMT e o LCD (HD44780 atrás de
+ *     um PCF8574) tem driver próprio sobre o Wire – nenhuma
+ *     biblioteca externa.
  *
  * ============================================================
  */
 
 #include <Arduino.h>
-#include <DHT.h>
-#include <LiquidCrystal_I2C.h>
+#include <Wire.h>
 #include <WiFi.h>
 #include <WebServer.h>
+#include <atomic>
+#include <esp_timer.h>
+#include <LittleFS.h>
+#include <driver/rmt.h>
+#include <driver/gpio.h>
+#include <driver/i2s.h>
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+#include <esp_pm.h>
+#include <esp_freertos_hooks.h>
+#include <esp_heap_caps.h>
+#include <lwip/sockets.h>
+#include "pagina_gz.h"
+#include "controle.h"
 
 // ──────────────────────────────────────────────────────────
 //  CONFIGURAÇÃO DO ACCESS POINT  ← altere aqui antes de gravar
@@ -91,12 +126,12 @@ const char* AP_SENHA = "estufa123";       // Senha (mínimo 8 caracteres, deixe
 #define PIN_LDR           34
 #define PIN_RELAY_LAMPADA  2
 #define PIN_RELAY_MOTOR   15
+#define PIN_SDA           21
+#define PIN_SCL           22
 
 // ──────────────────────────────────────────────────────────
 //  PARÂMETROS – valores padrão (editáveis em tempo real pela web)
 // ──────────────────────────────────────────────────────────
-#define TIPO_DHT  DHT22
-
 // Histérese – Motor
 float cfg_tempLigar   = 30.0;   // Motor liga   se T  >  este valor (°C)
 float cfg_tempDeslig  = 27.0;   // Motor desliga se T  <  este valor (°C)
@@ -112,6 +147,141 @@ int   cfg_luzDeslig   = 35;     // Lâmpada desliga se Luz >  este valor (%)
 // ──────────────────────────────────────────────────────────
 #define TEMPO_TELA      10000   // 10 s entre telas no LCD
 #define TEMPO_LEITURA    1000   // 1 s  entre leituras dos sensores
+#define TEMPO_SSE_KEEPALIVE 10000 // 10 s – reenvia o estado mesmo sem mudança
+
+// ──────────────────────────────────────────────────────────
+//  HAL – HARDWARE REAL OU SIMULADO
+// ──────────────────────────────────────────────────────────
+#ifndef HAL_SIMULADA            // o alvo de host (tools/host) compila com -DHAL_SIMULADA=1
+#define HAL_SIMULADA      0     // 1 = sensores seguem um traço roteirizado e
+                                //     relés/LCD só aparecem no Monitor Serie
+#endif
+#ifndef SIM_ACELERACAO
+#define SIM_ACELERACAO   60     // segundos simulados por segundo real
+#endif
+
+#if HAL_SIMULADA
+  #define PERIODO_AMOSTRA_MS  (TEMPO_LEITURA / SIM_ACELERACAO ? TEMPO_LEITURA / SIM_ACELERACAO : 1)
+#else
+  #define PERIODO_AMOSTRA_MS  TEMPO_LEITURA
+#endif
+
+// ──────────────────────────────────────────────────────────
+//  ENERGIA (/api/energia)
+// ──────────────────────────────────────────────────────────
+#define ENERGIA_ECONOMIA      1     // 1 = DFS 240↔80 MHz (+ light sleep se o sdkconfig permitir)
+#define ENERGIA_FREQ_MAX    240     // MHz
+#define ENERGIA_FREQ_MIN     80     // MHz – o WiFi não aceita menos
+#define ENERGIA_FIXO80        0     // 1 = sem esp_pm no core, prende a CPU em ENERGIA_FREQ_MIN
+                                    //     (tudo fica 3x mais lento, inclusive as respostas web)
+#define WEB_ESPERA_MS         1     // intervalo entre handleClient() com alguém conectado
+#define WEB_ESPERA_OCIOSO_MS  (ENERGIA_ECONOMIA ? 10 : 1)   // ninguém no AP nem no SSE: o clock cai
+                                    // entre voltas; o 1º pedido espera até 10 ms a mais
+
+// Estimativa de corrente (mA, 3,3 V) – valores típicos do datasheet do ESP32
+#define CORRENTE_AP_MA      100.0f  // rádio do AP sempre escutando (o AP não dorme)
+#define CORRENTE_ATIVA_MA    40.0f  // por núcleo ativo a ENERGIA_FREQ_MAX
+#define CORRENTE_ATIVA_80_MA 15.0f  // por núcleo ativo a ENERGIA_FREQ_MIN (modo fixo80)
+#define CORRENTE_OCIOSA_MA    8.0f  // por núcleo em WAITI a ENERGIA_FREQ_MIN
+#define CORRENTE_OCIOSA_FIXA_MA 20.0f // por núcleo em WAITI sem DFS (clock cheio)
+
+// ──────────────────────────────────────────────────────────
+//  SERVER-SENT EVENTS (/api/stream)
+// ──────────────────────────────────────────────────────────
+#define SSE_MAX_CLIENTES  4     // sockets longos simultâneos (lwIP tem ~10 no total)
+#define SSE_TRAVADO_MS 5000     // cliente que não aceita nenhum byte por 5 s é desconectado
+#define SSE_CABECALHO_TAM 128   // resposta HTTP que abre o stream (vai no 1º pendente)
+#define JSON_TAM_ESTADO 640     // pior caso de /api/data: ver tools/host/teste_json.cpp
+
+// ──────────────────────────────────────────────────────────
+//  RESPOSTAS LONGAS (/, /api/history, /api/log)
+// ──────────────────────────────────────────────────────────
+#define RESP_MAX_CLIENTES   4   // downloads simultâneos; o seguinte recebe 503
+#define RESP_PEND_TAM    1024   // pedaço em RAM por download
+#define RESP_PEDACOS_VOLTA  4   // pedaços por download a cada volta da tarefa web
+#define HIST_BLOCOS_PEDACO 64   // blocos do anel decodificados por pedaço de /api/history
+
+// ──────────────────────────────────────────────────────────
+//  TAREFAS FreeRTOS (núcleo / prioridade / pilha em bytes)
+// ──────────────────────────────────────────────────────────
+#define CTRL_NUCLEO       1
+#define CTRL_PRIORIDADE   4     // a mais alta: relés nunca esperam
+#define CTRL_PILHA     4096
+#define AGENDA_NUCLEO     1     // eventos com prazo: amostragem, troca de tela, log serial
+#define AGENDA_PRIORIDADE 3
+#define AGENDA_PILHA   4096
+#define AGENDA_MAX        8     // eventos periódicos simultâneos
+#define DISP_NUCLEO       1
+#define DISP_PRIORIDADE   1     // LCD I2C e Serial são lentos – ficam por último
+#define DISP_PILHA     4096
+#define WEB_NUCLEO        0     // mesmo núcleo da pilha WiFi
+#define WEB_PRIORIDADE    1
+#define WEB_PILHA      8192
+
+#define LDR_NUCLEO        1
+#define LDR_PRIORIDADE    2     // filtro do LDR: acorda a cada bloco de DMA
+#define LDR_PILHA      3072
+
+#define FILA_CONTROLE_TAM 8     // pedidos pendentes para a tarefa de controle
+
+// ──────────────────────────────────────────────────────────
+//  LDR – AQUISIÇÃO CONTÍNUA (ADC1 → I2S → DMA)
+// ──────────────────────────────────────────────────────────
+#define LDR_TAXA_HZ    8000     // amostras/s entregues pelo DMA
+#define LDR_BLOCO       250     // amostras por bloco (≈ 31 ms) – média = 1º estágio
+#define LDR_EMA_SHIFT     3     // EMA sobre a mediana de 3 blocos: α = 1/8 (τ ≈ 0,25 s)
+
+// Modelo do divisor para lux (LDR no 3V3, resistor fixo no GND)
+#define LDR_VCC_MV     3300
+#define LDR_R_FIXO    10000.0f  // Ω
+#define LDR_R_10LUX   15000.0f  // Ω do LDR a 10 lux (GL5528: 10–20 kΩ)
+#define LDR_GAMA         0.7f   // inclinação log(R) × log(lux) do datasheet
+
+// ──────────────────────────────────────────────────────────
+//  HISTÓRICO EM RAM (1 amostra/s, deltas comprimidos)
+// ──────────────────────────────────────────────────────────
+//  HIST_BLOCOS × sizeof(BlocoHist) = 1440 × 40 B ≈ 56 KB.
+//  Sinal estável: 64 amostras/bloco → ~25 h; sinal ruidoso
+//  fecha blocos antes e a janela encolhe (os mais antigos saem).
+//  Anéis e tabela de lux saem do heap no boot, depois do WiFi:
+//  as capacidades abaixo são o máximo e caem pela metade até
+//  sobrar MEMORIA_RESERVA livre para o lwIP (sockets, SSE).
+#define HIST_BLOCOS          1440
+#define HIST_AMOSTRAS_BLOCO    64
+#define HIST_DADOS_BYTES       28   // 224 bits de deltas por bloco
+#define HIST_MAX_BALDES      1440   // limite de pontos por resposta de /api/history
+#define RESUMO_MIN_CAP       1440   // 24 h de resumos de 1 min  (28 B cada)
+#define RESUMO_HORA_CAP       336   // 14 dias de resumos de 1 h
+#define MEMORIA_RESERVA     49152   // bytes que o boot deixa livres no heap interno
+
+// ──────────────────────────────────────────────────────────
+//  LOG PERSISTENTE (LittleFS, segmentos só-anexa)
+// ──────────────────────────────────────────────────────────
+#define LOG_DIR             "/log"
+#define LOG_PAGINA           1024   // bytes acumulados em RAM antes de gravar (64 registros)
+#define LOG_FLUSH_MS        60000   // grava a página parcial a cada 1 min (transição de relé: na hora)
+#define LOG_SEGMENTO_MAX    65536   // bytes por arquivo de segmento
+#define LOG_SEGMENTOS_MAX      16   // mantém ~1 MB; o segmento mais antigo é apagado
+#define LOG_FILA_TAM           64   // registros aguardando a tarefa de log
+#define LOG_NUCLEO              0
+#define LOG_PRIORIDADE          1
+#define LOG_PILHA            4096
+
+// ──────────────────────────────────────────────────────────
+//  SAÚDE DOS SENSORES E MODO DEGRADADO
+// ──────────────────────────────────────────────────────────
+#define SAUDE_VELHO_S          60   // DHT22 sem leitura aceita há mais que isso → velho
+#define SAUDE_TRAVADO_S      1800   // mesmo valor exato por 30 min → travado
+#define SAUDE_DTEMP_MAX      3.0f   // °C entre transações (2 s) – acima é implausível
+#define SAUDE_DUMID_MAX     15.0f   // %  entre transações
+#define SAUDE_IMPLAUSIVEL_MAX   5   // saltos seguidos aceitos como novo patamar
+#define DEGRADADO_CICLO_S    1800   // sem DHT22 confiável o motor ventila
+#define DEGRADADO_MOTOR_S     600   //   10 min a cada 30 min; sem LDR a lâmpada desliga
+
+// ──────────────────────────────────────────────────────────
+//  PROTEÇÃO DOS RELÉS (valem também para /api/relay no modo manual)
+//  LAMP_* / MOTOR_* ficam em controle.h, junto com o simulador
+// ──────────────────────────────────────────────────────────
 
 // ──────────────────────────────────────────────────────────
 //  LCD
@@ -119,39 +289,279 @@ int   cfg_luzDeslig   = 35;     // Lâmpada desliga se Luz >  este valor (%)
 #define LCD_ENDERECO  0x27
 #define LCD_COLUNAS     16
 #define LCD_LINHAS       2
+#ifndef LCD_I2C_HZ
+#define LCD_I2C_HZ  100000      // máximo do PCF8574/PCF8574A no datasheet
+#endif                          // 400000 só com PCA8574 no backpack (mesma pinagem, até 400 kHz)
+#define LCD_BYTES_POR_OP 4      // 2 nibbles × (dado|EN, dado) por caractere ou comando
+// reescrita completa, uma transação por linha: endereço + preparo do RS
+// do setCursor e dos dados + setCursor e 16 caracteres (teste_lcd confere)
+#define LCD_BYTES_REESCRITA (LCD_LINHAS * (3 + (LCD_COLUNAS + 1) * LCD_BYTES_POR_OP))
 
 // ──────────────────────────────────────────────────────────
 //  OBJETOS GLOBAIS
 // ──────────────────────────────────────────────────────────
-DHT               dht(PIN_DHT, TIPO_DHT);
-LiquidCrystal_I2C lcd(LCD_ENDERECO, LCD_COLUNAS, LCD_LINHAS);
 WebServer         server(80);
+QueueHandle_t     filaControle;  // MsgControle → tarefaControle
+TaskHandle_t      displayTarefa = nullptr;   // notificada quando o LCD precisa redesenhar
 
 // ──────────────────────────────────────────────────────────
-//  VARIÁVEIS DE ESTADO
+//  VARIÁVEIS DE ESTADO – pertencem à tarefa de controle;
+//  as demais tarefas leem a cópia publicada (lerEstado)
 // ──────────────────────────────────────────────────────────
-float temperatura = 0.0;
-float umidade     = 0.0;
+float temperatura = NAN;       // NaN até a 1ª leitura aceita do DHT22
+float umidade     = NAN;
 int   pctLuz      = 0;
+int   lux         = 0;
 
-bool lampada      = false;     // estado real aplicado ao relé
+bool lampada      = false;     // estado real aplicado ao relé (espelho de reles[])
 bool motor        = false;
 
 bool modoManual   = false;     // false = auto | true = manual
 bool lampManual   = false;     // controle manual – lâmpada
 bool motManual    = false;     // controle manual – motor
 
-int           tela     = 0;    // 0 dados | 1 status | 2 rede
-unsigned long tTroca   = 0;
-unsigned long tLeitura = 0;
+uint32_t dhtContagem[4]  = {}; // transações do DHT22 por StatusDHT
+uint8_t  dhtStatus       = 0;  // StatusDHT da última transação
+uint32_t dhtUltimaTrans  = 0;  // t_ms da última transação contada
+
+// Estatísticas do dia – zeradas quando halSegundos() / 86400 muda
+// (sem RTC, "hoje" é o dia corrente do relógio do sistema)
+uint32_t diaAtual    = 0;
+float    tempMinDia  = NAN, tempMaxDia = NAN;   // NaN até a 1ª leitura aceita
+float    umidMinDia  = NAN, umidMaxDia = NAN;
+uint32_t lampSegDia  = 0;      // s com a lâmpada ligada hoje
+uint32_t motSegDia   = 0;      // s com o motor ligado hoje
+uint32_t tUltimaMsg  = 0;      // halSegundos() da última mensagem de controle
+
+int           tela     = 0;    // índice em TELAS[]
+
+// Conexão /api/stream: o socket nunca recebe write() bloqueante. O que
+// a janela TCP não aceitou fica em pend e sai nas voltas seguintes da
+// tarefa web; enquanto sobra algo, frames novos só marcam 'atrasado'.
+struct ClienteSse {
+    WiFiClient    c;
+    char          pend[SSE_CABECALHO_TAM + JSON_TAM_ESTADO + 8];   // [cabeçalho HTTP] "data: …\n\n"
+    uint16_t      pendTam, pendPos;
+    bool          atrasado;                    // perdeu um frame; recebe o último ao escoar
+    unsigned long cheioDesde;                  // millis() do primeiro EAGAIN; 0 = escoando
+};
+ClienteSse    sseClientes[SSE_MAX_CLIENTES];   // conexões /api/stream abertas
+uint32_t      sseFramesPulados = 0;            // frames não enfileirados (cliente atrasado)
+char          sseUltimo[JSON_TAM_ESTADO];      // último estado enviado (p/ detectar mudança)
+size_t        sseUltimoLen = 0;
+unsigned long tSse         = 0;                // último envio (keepalive)
+volatile uint8_t sseConectados = 0;            // recontado pela tarefa web, lido pelo LCD
+
+uint32_t          latenciaMaxUs    = 0;  // pior tempo amostra → relé (µs)
+uint32_t          amostrasPerdidas = 0;  // fila de controle cheia
+
+// histograma da mesma latência desde o boot: a faixa k conta [2^k, 2^(k+1)) µs,
+// a última tudo acima de ~0,5 s – p50/p99 sem guardar amostras
+#define LAT_FAIXAS 20
+uint32_t          latenciaFaixas[LAT_FAIXAS];
+
+// ──────────────────────────────────────────────────────────
+//  MENSAGENS PARA A TAREFA DE CONTROLE
+// ──────────────────────────────────────────────────────────
+enum TipoMsg : uint8_t { MSG_AMOSTRA, MSG_MODO, MSG_RELE, MSG_CONFIG };
+
+enum StatusDHT : uint8_t { DHT_OK, DHT_TIMEOUT, DHT_INCOMPLETO, DHT_CHECKSUM };
+const char* const NOMES_STATUS_DHT[] = { "ok", "timeout", "incompleto", "checksum" };
+
+enum SaudeSensor : uint8_t { SAUDE_OK, SAUDE_VELHO, SAUDE_TRAVADO, SAUDE_IMPLAUSIVEL };
+const char* const NOMES_SAUDE[]     = { "ok", "velho", "travado", "implausivel" };
+const char* const NOMES_SAUDE_LCD[] = { "OK", "VELH", "TRAV", "IMPL" };   // 4 colunas
+
+// Uma transação do DHT22: o par vem sempre da mesma medição
+struct AmostraDHT { float temp, umid; uint32_t t_ms; StatusDHT status; };   // temp/umid só valem com DHT_OK
+
+struct Amostra    { AmostraDHT dht; int luz; uint16_t lux, adc, adcBrutoQ4; uint32_t t_us; };   // adcBrutoQ4: sem filtro
+struct PedidoRele { uint8_t canal; bool ligado; };                 // 0 lâmpada | 1 motor
+
+struct MsgControle {
+    TipoMsg tipo;
+    union {
+        Amostra    amostra;
+        bool       manual;
+        PedidoRele rele;
+        Limiares   cfg;
+    };
+};
+
+// Saúde de um sensor – avaliada em saudeAvaliar() (seção SAÚDE DOS SENSORES)
+struct SaudeCanal {
+    uint32_t    ultimoBom;        // halSegundos() da última leitura aceita
+    uint32_t    inicioIgual;      // desde quando o valor não muda
+    uint16_t    falhasSeguidas;   // falhas + saltos rejeitados desde a última aceita
+    float       a, b;             // último valor aceito (T/U ou ADC/–)
+    bool        temValor;
+    SaudeSensor estado;
+};
+
+// pertencem à tarefa de controle; "velho" até a primeira leitura aceita
+SaudeCanal saudeDht = { 0, 0, 0, NAN, NAN, false, SAUDE_VELHO };
+SaudeCanal saudeLdr = { 0, 0, 0, NAN, NAN, false, SAUDE_VELHO };
+
+// Proteção dos relés, por CanalRele (também da tarefa de controle).
+// desde = 0 vale como troca no boot: um reset em laço não vira ciclagem.
+EstadoRele       reles[2] = {};
+const LimiteRele LIMITES_RELE[2] = {
+    { LAMP_MIN_LIGADA_S,  LAMP_MIN_DESLIG_S,  LAMP_MAX_POR_HORA  },
+    { MOTOR_MIN_LIGADO_S, MOTOR_MIN_DESLIG_S, MOTOR_MAX_POR_HORA },
+};
 
 // ══════════════════════════════════════════════════════════
-//  FUNÇÕES AUXILIARES
+//  ESTADO COMPARTILHADO – seqlock
+//  A tarefa de controle é a única escritora e nunca espera;
+//  leitores (JSON, LCD, log) copiam e repetem se a cópia
+//  cruzou uma publicação, então nunca veem valores misturados.
 // ══════════════════════════════════════════════════════════
-String pad16(const String& s) {
-    String r = s;
-    while ((int)r.length() < 16) r += ' ';
-    return r.substring(0, 16);
+struct EstadoEstufa {
+    uint32_t versao;                 // nº da última publicação que mudou o estado
+    float    temperatura, umidade;
+    int32_t  pctLuz;
+    int32_t  lux;
+    Limiares cfg;
+    float    tempMinDia, tempMaxDia, umidMinDia, umidMaxDia;   // NaN até a 1ª leitura do dia
+    bool     lampada, motor, modoManual, lampManual, motManual;
+    uint8_t  dhtStatus, saudeDht, saudeLdr;   // StatusDHT / SaudeSensor
+    uint8_t  releTrocasHora[2];
+    bool     relePendente[2];
+    uint16_t dhtFalhasSeguidas;
+
+    // ── diagnóstico: andam a cada transação ou segundo; vão na cópia,
+    //    mas não contam como mudança (nem versão, nem SSE, nem LCD) ──
+    uint32_t dhtContagem[4];         // por StatusDHT
+    uint32_t dhtUltimoBom;           // halSegundos() da última leitura aceita
+    uint32_t lampSegDia, motSegDia;  // s ligado hoje
+    uint32_t releSuprimidos[2];      // por CanalRele
+};
+#define ESTADO_COMPARADO  offsetof(EstadoEstufa, dhtContagem)   // bytes que definem "mudou"
+
+#define ESTADO_PALAVRAS  (sizeof(EstadoEstufa) / 4)
+static_assert(sizeof(EstadoEstufa) % 4 == 0, "EstadoEstufa deve ocupar palavras inteiras");
+
+std::atomic<uint32_t> estadoSeq{0};                      // ímpar = publicação em andamento
+std::atomic<uint32_t> estadoPalavras[ESTADO_PALAVRAS];   // cópia publicada, palavra a palavra
+std::atomic<uint32_t> estadoVersao{0};                   // = versao da última cópia publicada
+
+/**
+ * Copia as variáveis de estado para o seqlock (só a tarefa de controle
+ * chama). Só o diagnóstico mudou: publica (o /api/data fica em dia)
+ * mas a versão não anda. Retorna true se a versão andou – só aí SSE e
+ * LCD têm o que refazer.
+ */
+bool publicarEstado() {
+    static EstadoEstufa anterior;
+    static bool         publicado = false;
+    EstadoEstufa e;
+    memset(&e, 0, sizeof(e));   // zera o padding
+    uint32_t seq = estadoSeq.load(std::memory_order_relaxed);
+    e.temperatura = temperatura;
+    e.umidade     = umidade;
+    e.pctLuz      = pctLuz;
+    e.lux         = lux;
+    e.cfg         = { cfg_tempLigar, cfg_tempDeslig, cfg_umidLigar, cfg_umidDeslig,
+                      cfg_luzLigar,  cfg_luzDeslig };
+    e.lampada     = lampada;     e.motor     = motor;
+    e.modoManual  = modoManual;  e.lampManual = lampManual;  e.motManual = motManual;
+    memcpy(e.dhtContagem, dhtContagem, sizeof(dhtContagem));
+    e.dhtStatus   = dhtStatus;
+    e.dhtUltimoBom      = saudeDht.ultimoBom;
+    e.dhtFalhasSeguidas = saudeDht.falhasSeguidas;
+    e.saudeDht    = saudeDht.estado;
+    e.saudeLdr    = saudeLdr.estado;
+    e.tempMinDia  = tempMinDia;  e.tempMaxDia = tempMaxDia;
+    e.umidMinDia  = umidMinDia;  e.umidMaxDia = umidMaxDia;
+    e.lampSegDia  = lampSegDia;  e.motSegDia  = motSegDia;
+    for (int c = 0; c < 2; c++) {
+        e.releSuprimidos[c] = reles[c].suprimidos;
+        e.releTrocasHora[c] = releTrocasHora(reles[c], tUltimaMsg);
+        e.relePendente[c]   = reles[c].pendente;
+    }
+
+    e.versao = anterior.versao;
+    if (publicado && memcmp(&e, &anterior, sizeof(e)) == 0) return false;
+    bool mudou = !publicado || memcmp(&e, &anterior, ESTADO_COMPARADO) != 0;
+    if (mudou) e.versao++;
+    anterior  = e;
+    publicado = true;
+
+    uint32_t p[ESTADO_PALAVRAS];
+    memcpy(p, &e, sizeof(e));
+
+    estadoSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < ESTADO_PALAVRAS; i++)
+        estadoPalavras[i].store(p[i], std::memory_order_relaxed);
+    estadoSeq.store(seq + 2, std::memory_order_release);
+    estadoVersao.store(e.versao, std::memory_order_release);
+    return mudou;
+}
+
+/** Snapshot consistente do estado; repete enquanto houver escrita concorrente */
+void lerEstado(EstadoEstufa& e) {
+    uint32_t p[ESTADO_PALAVRAS];
+    for (;;) {
+        uint32_t seq = estadoSeq.load(std::memory_order_acquire);
+        if (seq & 1) continue;
+        for (size_t i = 0; i < ESTADO_PALAVRAS; i++)
+            p[i] = estadoPalavras[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (estadoSeq.load(std::memory_order_relaxed) == seq) break;
+    }
+    memcpy(&e, p, sizeof(e));
+}
+
+/** Versão do estado (só anda quando algo além do diagnóstico muda) – barato, sem copiar */
+uint32_t versaoEstado() { return estadoVersao.load(std::memory_order_acquire); }
+
+// ══════════════════════════════════════════════════════════
+//  JSON – escrita em buffer fixo (nenhuma alocação no heap)
+// ══════════════════════════════════════════════════════════
+struct JsonBuf {
+    char*  buf;
+    size_t cap;       // inclui o terminador '\0'
+    size_t len;
+    bool   estouro;   // true se algo foi truncado
+};
+
+void jsonIniciar(JsonBuf& j, char* buf, size_t cap) {
+    j.buf = buf;  j.cap = cap;  j.len = 0;  j.estouro = false;
+    if (cap) buf[0] = '\0';
+}
+
+void jsonAnexar(JsonBuf& j, const char* s, size_t n) {
+    if (j.len + n >= j.cap) { j.estouro = true; n = (j.len + 1 < j.cap) ? j.cap - 1 - j.len : 0; }
+    if (!j.cap) return;   // nem o terminador cabe
+    memcpy(j.buf + j.len, s, n);
+    j.len += n;
+    j.buf[j.len] = '\0';
+}
+
+void jsonTexto(JsonBuf& j, const char* s) { jsonAnexar(j, s, strlen(s)); }
+
+void jsonInteiro(JsonBuf& j, long v) {
+    char tmp[20];   // long de 64 bits no host: 19 dígitos + sinal
+    int  i = sizeof(tmp);
+    unsigned long u = (v < 0) ? 0UL - (unsigned long)v : (unsigned long)v;
+    do { tmp[--i] = '0' + (u % 10); u /= 10; } while (u);
+    if (v < 0) tmp[--i] = '-';
+    jsonAnexar(j, tmp + i, sizeof(tmp) - i);
+}
+
+/** inteiro em décimos escrito com 1 casa decimal (253 → 25.3) */
+void jsonDecimos(JsonBuf& j, long d) {
+    if (d < 0) { jsonTexto(j, "-"); d = -d; }
+    jsonInteiro(j, d / 10);
+    char frac[2] = { '.', (char)('0' + d % 10) };
+    jsonAnexar(j, frac, 2);
+}
+
+/** número com 1 casa decimal (como String(v,1); empates para longe do zero); NaN vira null */
+void jsonDecimal1(JsonBuf& j, float v) {
+    if (isnan(v) || isinf(v)) { jsonTexto(j, "null"); return; }
+    jsonDecimos(j, lround(v * 10.0));   // em double: v*10.0f arredonda -39.85f para -398.5
 }
 
 // ══════════════════════════════════════════════════════════
@@ -182,375 +592,2100 @@ void configurarAP() {
     }
 }
 
+// ══════════════════════════════════════════════════════════
+//  HAL – único ponto que toca sensores, relés, LCD e relógio
+//  O resto do firmware só chama hal*(); com HAL_SIMULADA = 1 a
+//  lógica de controle, histórico, log e web roda numa placa sem
+//  nada ligado, em tempo acelerado, com um traço de sensores
+//  roteirizado.
+// ══════════════════════════════════════════════════════════
+enum CanalRele : uint8_t { RELE_LAMPADA, RELE_MOTOR };
+
+uint32_t halMicros() { return micros(); }
+
+// ── LCD HD44780 via PCF8574 ───────────────────────────────────
+//  Pinos do backpack: P0 RS | P1 RW | P2 EN | P3 luz | P4–P7 D4–D7.
+//  Cada nibble vira 2 bytes no expansor (dado|EN, dado – o HD44780
+//  captura na borda de descida). Os bytes se acumulam em lcdLote e
+//  saem numa única transação I2C em halLcdEnviar(). A 100 kHz cada
+//  byte leva 90 µs (8 bits + ACK): entre duas bordas de EN passam
+//  ≥ 180 µs, bem mais que os 37 µs de cada comando, então nenhum
+//  delay é preciso entre caracteres. Um dígito trocado (setCursor +
+//  1 caractere) são 11 bytes ≈ 1 ms; o quadro inteiro, ~143 bytes
+//  em 2 transações ≈ 13 ms (≈ 3,2 ms com LCD_I2C_HZ = 400000).
+//  O Wire do core espera a transação no driver com interrupções:
+//  a tarefa dorme, a CPU fica livre. Fica fora do #if: a HAL
+//  simulada manda os mesmos bytes ao Wire do host (tools/host),
+//  onde o teste_lcd os conta e decodifica.
+#define PCF_RS    0x01
+#define PCF_EN    0x04
+#define PCF_LUZ   0x08
+#define LCD_LOTE   120          // cabe no buffer de 128 B do Wire
+
+uint8_t  lcdLote[LCD_LOTE];
+uint8_t  lcdLoteTam = 0;
+int8_t   lcdPinosRs = -1;      // RS que o expansor segura entre transações (-1 = boot)
+uint32_t lcdBytesBarramento = 0;   // inclui o byte de endereço de cada transação
+
+void halLcdEnviar() {
+    if (lcdLoteTam == 0) return;
+    Wire.beginTransmission(LCD_ENDERECO);
+    Wire.write(lcdLote, lcdLoteTam);
+    Wire.endTransmission();
+    lcdBytesBarramento += lcdLoteTam + 1;
+    lcdLoteTam = 0;
+}
+
+void lcdLoteNibble(uint8_t nibble, bool rs) {
+    uint8_t b = (nibble << 4) | PCF_LUZ | (rs ? PCF_RS : 0);
+    if (lcdLoteTam + 3 > LCD_LOTE) halLcdEnviar();
+    if (rs != lcdPinosRs) lcdLote[lcdLoteTam++] = b;   // RS estável antes do EN subir
+    lcdLote[lcdLoteTam++] = b | PCF_EN;
+    lcdLote[lcdLoteTam++] = b;
+    lcdPinosRs = rs;
+}
+
+/** Comando (rs = false) ou caractere (rs = true) */
+void lcdLoteByte(uint8_t v, bool rs) {
+    lcdLoteNibble(v >> 4,   rs);
+    lcdLoteNibble(v & 0x0F, rs);
+}
+
+void lcdLoteCursor(uint8_t col, uint8_t linha) {
+    static const uint8_t INICIO_LINHA[] = { 0x00, 0x40 };
+    lcdLoteByte(0x80 | (INICIO_LINHA[linha] + col), false);   // set DDRAM address
+}
+
+#if !HAL_SIMULADA
+
+// ── DHT22 pelo RMT ────────────────────────────────────────────
+//  O firmware só gera o pulso de início (≥ 1 ms em LOW); o RMT
+//  cronometra sozinho o trem de 40 bits e entrega os pulsos num
+//  ring buffer. A tarefa de sensores dorme esperando o quadro, com
+//  interrupções ligadas – WiFi e servidor web não param.
+//  Bit = 50 µs LOW + HIGH de ~26 µs (0) ou ~70 µs (1).
+#define DHT_RMT_CANAL     RMT_CHANNEL_4
+#define DHT_INTERVALO_MS  2000    // o DHT22 não mede mais rápido que isso
+#define DHT_TIMEOUT_MS      20    // quadro completo leva ~5 ms
+
+RingbufHandle_t dhtAnel    = nullptr;
+AmostraDHT      dhtUltima  = { NAN, NAN, 0, DHT_TIMEOUT };   // última transação
+
+void dhtIniciar() {
+    rmt_config_t c = RMT_DEFAULT_CONFIG_RX((gpio_num_t)PIN_DHT, DHT_RMT_CANAL);
+    c.clk_div = 80;                           // 1 tick = 1 µs
+    c.rx_config.filter_en           = true;
+    c.rx_config.filter_ticks_thresh = 100;    // ignora ruído < 1,25 µs (ciclos do APB)
+    c.rx_config.idle_threshold      = 150;    // 150 µs sem borda = fim do quadro
+    rmt_config(&c);
+    rmt_driver_install(DHT_RMT_CANAL, 1024, 0);
+    rmt_get_ringbuf_handle(DHT_RMT_CANAL, &dhtAnel);
+
+    // dreno aberto: nível 1 solta a linha (pull-up), e o RMT continua lendo o pino
+    gpio_set_pull_mode((gpio_num_t)PIN_DHT, GPIO_PULLUP_ONLY);
+    gpio_set_level((gpio_num_t)PIN_DHT, 1);
+    gpio_set_direction((gpio_num_t)PIN_DHT, GPIO_MODE_INPUT_OUTPUT_OD);
+}
+
+// ── LDR contínuo ──────────────────────────────────────────────
+//  O I2S0 dispara o ADC1 sozinho e o DMA entrega blocos de
+//  LDR_BLOCO amostras; a CPU só acorda por bloco. Filtro em
+//  ponto fixo (Q4 = 1/16 de contagem do ADC):
+//    média do bloco → mediana dos 3 últimos blocos (tira os
+//    picos de ruído do rádio) → EMA com α = 2^-LDR_EMA_SHIFT.
+//  A média do último bloco sai também crua: o ruído do ADC que o
+//  filtro apaga é o que prova à saúde que o sensor está vivo.
+std::atomic<int32_t> ldrFiltradoQ4{0};
+std::atomic<int32_t> ldrBrutoQ4{0};
+esp_adc_cal_characteristics_t adcCal;   // curva do ADC1 a 11 dB a partir do eFuse
+
+void tarefaLDR(void*) {
+    static uint16_t bloco[LDR_BLOCO];
+    int32_t  med[3]  = {0, 0, 0};
+    uint32_t blocos  = 0;
+    int32_t  ema     = 0;
+    for (;;) {
+        size_t lidos = 0;
+        i2s_read(I2S_NUM_0, bloco, sizeof(bloco), &lidos, portMAX_DELAY);
+        size_t n = lidos / sizeof(uint16_t);
+        if (n == 0) continue;
+
+        uint32_t soma = 0;
+        for (size_t i = 0; i < n; i++) soma += bloco[i] & 0x0FFF;   // 4 bits altos = canal
+        med[blocos % 3] = (int32_t)((soma << 4) / n);
+        ldrBrutoQ4.store(med[blocos % 3], std::memory_order_relaxed);
+        blocos++;
+
+        int32_t a = med[0], b = med[1], c = med[2];
+        int32_t m = blocos < 3 ? med[(blocos - 1) % 3]
+                               : max(min(a, b), min(max(a, b), c));
+        ema = blocos == 1 ? m : ema + ((m - ema) >> LDR_EMA_SHIFT);
+        ldrFiltradoQ4.store(ema, std::memory_order_relaxed);
+    }
+}
+
+void ldrIniciar() {
+    i2s_config_t c = {};
+    c.mode                 = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+    c.sample_rate          = LDR_TAXA_HZ;
+    c.bits_per_sample      = I2S_BITS_PER_SAMPLE_16BIT;
+    c.channel_format       = I2S_CHANNEL_FMT_ONLY_LEFT;
+    c.communication_format = I2S_COMM_FORMAT_STAND_MSB;
+    c.dma_buf_count        = 4;
+    c.dma_buf_len          = LDR_BLOCO;
+    c.use_apll             = false;
+    i2s_driver_install(I2S_NUM_0, &c, 0, nullptr);
+    i2s_set_adc_mode(ADC_UNIT_1, ADC1_CHANNEL_6);            // GPIO 34
+    adc1_config_channel_atten(ADC1_CHANNEL_6, ADC_ATTEN_DB_11); // 0–3,3 V, como o analogRead()
+    esp_adc_cal_value_t fonte = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11,
+                                                         ADC_WIDTH_BIT_12, 1100, &adcCal);
+    Serial.printf("[ADC] calibração: %s\n", fonte == ESP_ADC_CAL_VAL_EFUSE_TP   ? "eFuse two-point" :
+                                            fonte == ESP_ADC_CAL_VAL_EFUSE_VREF ? "eFuse Vref" : "Vref padrão");
+    i2s_adc_enable(I2S_NUM_0);
+
+    xTaskCreatePinnedToCore(tarefaLDR, "ldr", LDR_PILHA, nullptr,
+                            LDR_PRIORIDADE, nullptr, LDR_NUCLEO);
+}
+
+/** Os 40 bits são os 40 últimos pulsos HIGH do quadro (a resposta de 80 µs vem antes) */
+StatusDHT dhtDecodificar(const rmt_item32_t* it, size_t n, uint8_t dados[5]) {
+    uint16_t altos[96];
+    size_t   na = 0;
+    for (size_t i = 0; i < n && na < 95; i++) {
+        if (it[i].level0 && it[i].duration0 < 100) altos[na++] = it[i].duration0;
+        if (it[i].level1 && it[i].duration1 < 100) altos[na++] = it[i].duration1;
+    }
+    if (na < 40) return DHT_INCOMPLETO;
+
+    memset(dados, 0, 5);
+    for (size_t b = 0; b < 40; b++)
+        if (altos[na - 40 + b] > 48) dados[b / 8] |= 0x80 >> (b % 8);
+    return (uint8_t)(dados[0] + dados[1] + dados[2] + dados[3]) == dados[4] ? DHT_OK : DHT_CHECKSUM;
+}
+
+/** Uma transação devolve o par; chamadas a menos de 2 s repetem a última (mesmo t_ms) */
+AmostraDHT halLerDHT() {
+    uint32_t agora = millis();
+    if (dhtUltima.t_ms && agora - dhtUltima.t_ms < DHT_INTERVALO_MS) return dhtUltima;
+
+    AmostraDHT a = { NAN, NAN, agora ? agora : 1, DHT_TIMEOUT };
+    gpio_set_level((gpio_num_t)PIN_DHT, 0);           // início: ≥ 1 ms em LOW
+    vTaskDelay(pdMS_TO_TICKS(2));
+    gpio_set_level((gpio_num_t)PIN_DHT, 1);
+    rmt_rx_start(DHT_RMT_CANAL, true);
+
+    size_t tam = 0;
+    rmt_item32_t* it = (rmt_item32_t*)xRingbufferReceive(dhtAnel, &tam, pdMS_TO_TICKS(DHT_TIMEOUT_MS));
+    rmt_rx_stop(DHT_RMT_CANAL);
+    if (it) {
+        uint8_t d[5];
+        a.status = dhtDecodificar(it, tam / sizeof(rmt_item32_t), d);
+        vRingbufferReturnItem(dhtAnel, it);
+        if (a.status == DHT_OK) {
+            a.umid = ((d[0] << 8) | d[1]) * 0.1f;
+            a.temp = (((d[2] & 0x7F) << 8) | d[3]) * 0.1f;
+            if (d[2] & 0x80) a.temp = -a.temp;
+        }
+    }
+    dhtUltima = a;
+    return a;
+}
+
+void lcdHwIniciar() {
+    Wire.begin(PIN_SDA, PIN_SCL, LCD_I2C_HZ);
+    delay(50);                                   // HD44780 após ligar
+
+    // sequência do datasheet para entrar em 4 bits
+    lcdLoteNibble(0x03, false);  halLcdEnviar();  delay(5);
+    lcdLoteNibble(0x03, false);  halLcdEnviar();  delayMicroseconds(150);
+    lcdLoteNibble(0x03, false);  halLcdEnviar();
+    lcdLoteNibble(0x02, false);  halLcdEnviar();
+
+    lcdLoteByte(0x28, false);    // 4 bits, 2 linhas, 5x8
+    lcdLoteByte(0x0C, false);    // display ligado, sem cursor
+    lcdLoteByte(0x06, false);    // cursor avança para a direita
+    lcdLoteByte(0x01, false);    // clear
+    halLcdEnviar();
+    delay(2);
+}
+
+void halIniciar() {
+    // relés: HIGH = desligado (active LOW)
+    pinMode(PIN_RELAY_LAMPADA, OUTPUT);
+    pinMode(PIN_RELAY_MOTOR,   OUTPUT);
+    digitalWrite(PIN_RELAY_LAMPADA, HIGH);
+    digitalWrite(PIN_RELAY_MOTOR,   HIGH);
+
+    lcdHwIniciar();
+
+    dhtIniciar();
+    ldrIniciar();
+}
+
+/** Valor filtrado do LDR (0–4095) – só lê o que a tarefaLDR publicou */
+int halLerLDR() { return (ldrFiltradoQ4.load(std::memory_order_relaxed) + 8) >> 4; }
+
+/** Média do último bloco DMA em Q4, sem mediana nem EMA – para a saúde */
+int halLdrBrutoQ4() { return ldrBrutoQ4.load(std::memory_order_relaxed); }
+
+/** Contagem do ADC → mV no pino, corrigida pela calibração de fábrica */
+uint32_t halAdcMilivolts(int adc) { return esp_adc_cal_raw_to_voltage(adc, &adcCal); }
+
+void halRele(CanalRele canal, bool ligado) {
+    // Active LOW: LOW = ligado
+    digitalWrite(canal == RELE_LAMPADA ? PIN_RELAY_LAMPADA : PIN_RELAY_MOTOR, ligado ? LOW : HIGH);
+}
+
+void halLcdLimpar() {
+    lcdLoteByte(0x01, false);    // clear display
+    halLcdEnviar();
+    delay(2);                    // clear leva 1,52 ms
+}
+
+void halLcdCursor(uint8_t col, uint8_t linha) { lcdLoteCursor(col, linha); }
+
+void halLcdEscrever(const char* s, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) lcdLoteByte((uint8_t)s[i], true);
+}
+
+uint32_t halSegundos() { return (uint32_t)(esp_timer_get_time() / 1000000); }
+
+#else   // ── HAL simulada ──────────────────────────────────────
+
+// Dia típico de estufa; interpolado linearmente e repetido a cada 24 h
+struct PontoTraco { uint32_t t; float temp, umid; int luz; };
+const PontoTraco SIM_TRACO_PADRAO[] = {
+    {     0, 18.0f, 85.0f,  0 },   // 00h – madrugada fria e úmida
+    { 21600, 17.0f, 88.0f,  5 },   // 06h – amanhecer
+    { 32400, 26.0f, 65.0f, 60 },   // 09h
+    { 46800, 33.0f, 50.0f, 95 },   // 13h – pico de calor
+    { 57600, 30.0f, 55.0f, 70 },   // 16h
+    { 68400, 22.0f, 72.0f, 10 },   // 19h – anoitecer
+    { 86400, 18.0f, 85.0f,  0 },   // 24h – fecha o ciclo
+};
+
+// Traço em uso: repete a cada simTracoPontos[simTracoTam - 1].t segundos. O
+// simulador de host troca por um CSV antes do setup().
+const PontoTraco* simTracoPontos = SIM_TRACO_PADRAO;
+size_t            simTracoTam    = sizeof(SIM_TRACO_PADRAO) / sizeof(SIM_TRACO_PADRAO[0]);
+
+bool simReles[2];
+char    simLcd[LCD_LINHAS][LCD_COLUNAS + 1];
+uint8_t simCol = 0, simLin = 0;
+
+uint32_t halSegundos() { return (uint32_t)(esp_timer_get_time() * SIM_ACELERACAO / 1000000); }
+
+const PontoTraco& simTraco(float& f) {
+    const PontoTraco* p = simTracoPontos;
+    uint32_t t = halSegundos() % p[simTracoTam - 1].t;
+    size_t   i = 0;
+    while (p[i + 1].t <= t) i++;
+    f = (float)(t - p[i].t) / (p[i + 1].t - p[i].t);
+    return p[i];
+}
+
+void halIniciar() {
+    Serial.println("[SIM] HAL simulada – " + String(SIM_ACELERACAO) + "x tempo real");
+}
+
+AmostraDHT halLerDHT() {
+    float f;
+    const PontoTraco& a = simTraco(f);
+    const PontoTraco& b = (&a)[1];
+    uint32_t agora = millis();
+    return { a.temp + (b.temp - a.temp) * f, a.umid + (b.umid - a.umid) * f,
+             agora ? agora : 1, DHT_OK };
+}
+
+/** ADC ideal na simulação: linear até 3,3 V */
+uint32_t halAdcMilivolts(int adc) { return (uint32_t)adc * LDR_VCC_MV / 4095; }
+
+int halLerLDR() {
+    float f;
+    const PontoTraco& a = simTraco(f);
+    const PontoTraco& b = (&a)[1];
+    return lroundf((a.luz + (b.luz - a.luz) * f) * 4095.0f / 100.0f);
+}
+
+/** Média de bloco com ruído de ±0,5 contagem (LCG), como o ADC real na cena parada */
+int halLdrBrutoQ4() {
+    static uint32_t lcg = 1;
+    lcg = lcg * 1664525u + 1013904223u;
+    int adc = halLerLDR();
+    if (adc <= 0 || adc >= 4095) return adc << 4;   // saturado não tem ruído
+    return (adc << 4) + (int)(lcg >> 28) - 8;
+}
+
+void halRele(CanalRele canal, bool ligado) {
+    if (simReles[canal] == ligado) return;
+    simReles[canal] = ligado;
+    Serial.printf("[SIM] t=%lus %s -> %s\n", (unsigned long)halSegundos(),
+                  canal == RELE_LAMPADA ? "lampada" : "motor", ligado ? "ON" : "OFF");
+}
+
+void halLcdLimpar() {
+    for (uint8_t l = 0; l < LCD_LINHAS; l++) memset(simLcd[l], ' ', LCD_COLUNAS);
+    simCol = simLin = 0;
+    lcdLoteByte(0x01, false);
+    halLcdEnviar();
+}
+
+void halLcdCursor(uint8_t col, uint8_t linha) {
+    simCol = col;  simLin = linha;
+    lcdLoteCursor(col, linha);
+}
+
+void halLcdEscrever(const char* s, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) lcdLoteByte((uint8_t)s[i], true);
+    for (uint8_t i = 0; i < n && simCol < LCD_COLUNAS; i++) simLcd[simLin][simCol++] = s[i];
+    Serial.printf("[SIM] LCD%u |%.16s|\n", simLin, simLcd[simLin]);
+}
+
+#endif
+
+// ══════════════════════════════════════════════════════════
+//  ENERGIA – DFS / light sleep e contabilidade ativo × ocioso
+//  Com o AP ligado o rádio segura a CPU acordada (o softAP não
+//  entra em modem sleep), então o ganho real vem do DFS: entre
+//  eventos o clock cai para ENERGIA_FREQ_MIN.
+//  Ocioso: o gancho de idle marca a entrada em WAITI e o gancho
+//  de tick (1 ms) soma o intervalo. Uma interrupção que não seja
+//  o tick e acorde uma tarefa conta como ociosa até o próximo
+//  tick – erro de no máximo 1 ms por acordada.
+//  A marca é de 32 bits: o tick é uma interrupção no meio do gancho
+//  de idle e um int64_t no Xtensa são duas escritas – ele poderia
+//  ler metade nova e metade velha. A diferença sem sinal continua
+//  certa enquanto o intervalo for menor que ~71 min.
+// ══════════════════════════════════════════════════════════
+const char* energiaModo = "desligado";   // "dfs+sleep" | "dfs" | "fixo80" | "desligado"
+
+volatile uint32_t ociosoDesde[2]   = { 0, 0 };     // µs (32 bits baixos) | 1; 0 = núcleo trabalhando
+volatile uint32_t ociosoRestoUs[2] = { 0, 0 };
+volatile uint32_t ociosoMs[2]      = { 0, 0 };     // só cresce; leitura de 32 bits é atômica
+int64_t           energiaInicioUs  = 0;
+
+bool IRAM_ATTR ganchoOcioso() {
+    int n = xPortGetCoreID();
+    if (!ociosoDesde[n]) ociosoDesde[n] = (uint32_t)esp_timer_get_time() | 1;   // uma escrita só
+    return true;   // pode executar WAITI
+}
+
+void IRAM_ATTR ganchoTick() {
+    int n = xPortGetCoreID();
+    uint32_t desde = ociosoDesde[n];
+    if (!desde) return;
+    uint32_t us = ociosoRestoUs[n] + ((uint32_t)esp_timer_get_time() - desde);
+    ociosoMs[n]      += us / 1000;
+    ociosoRestoUs[n]  = us % 1000;
+    ociosoDesde[n]    = 0;
+}
+
+void iniciarEnergia() {
+#if ENERGIA_ECONOMIA
+    esp_pm_config_esp32_t pm = { ENERGIA_FREQ_MAX, ENERGIA_FREQ_MIN, true };
+    if (esp_pm_configure(&pm) == ESP_OK) {
+        energiaModo = "dfs+sleep";
+    } else {
+        pm.light_sleep_enable = false;        // core sem tickless idle
+        if (esp_pm_configure(&pm) == ESP_OK) energiaModo = "dfs";
+#if ENERGIA_FIXO80
+        else if (setCpuFrequencyMhz(ENERGIA_FREQ_MIN)) energiaModo = "fixo80";   // core sem CONFIG_PM_ENABLE
+#endif
+    }
+#endif
+    energiaInicioUs = esp_timer_get_time();
+    for (int n = 0; n < 2; n++) {
+        esp_register_freertos_idle_hook_for_cpu(ganchoOcioso, n);
+        esp_register_freertos_tick_hook_for_cpu(ganchoTick, n);
+    }
+    Serial.printf("[PM] modo %s, CPU %lu MHz\n", energiaModo, (unsigned long)getCpuFrequencyMhz());
+}
+
+// ══════════════════════════════════════════════════════════
+//  AGENDA – min-heap de prazos
+//  Trabalho periódico vira evento com prazo; a tarefa da agenda
+//  dorme até o prazo mais próximo (a CPU fica ociosa entre
+//  eventos) e executa na ordem. agendar() só antes de a tarefa
+//  começar ou de dentro de um evento: o evento em execução sai do
+//  heap enquanto roda e volta depois, com o prazo seguinte.
+// ══════════════════════════════════════════════════════════
+typedef void (*FuncaoEvento)();
+
+struct Evento { uint32_t prazo, periodo; FuncaoEvento f; };   // ms (millis)
+
+Evento  agenda[AGENDA_MAX];   // agenda[0] = próximo prazo
+uint8_t agendaTam = 0;
+uint8_t agendaFora = 0;       // 1 enquanto um evento roda (fora do heap, mas com vaga reservada)
+
+bool agendaAntes(const Evento& a, const Evento& b) { return (int32_t)(a.prazo - b.prazo) < 0; }
+
+void agendaSubir(uint8_t i) {
+    while (i > 0) {
+        uint8_t pai = (i - 1) / 2;
+        if (!agendaAntes(agenda[i], agenda[pai])) break;
+        Evento t = agenda[i];  agenda[i] = agenda[pai];  agenda[pai] = t;
+        i = pai;
+    }
+}
+
+void agendaDescer(uint8_t i) {
+    for (;;) {
+        uint8_t menor = i, e = 2 * i + 1, d = 2 * i + 2;
+        if (e < agendaTam && agendaAntes(agenda[e], agenda[menor])) menor = e;
+        if (d < agendaTam && agendaAntes(agenda[d], agenda[menor])) menor = d;
+        if (menor == i) return;
+        Evento t = agenda[i];  agenda[i] = agenda[menor];  agenda[menor] = t;
+        i = menor;
+    }
+}
+
+/** Registra f para rodar a cada periodo ms, a primeira vez após atraso ms */
+bool agendar(FuncaoEvento f, uint32_t periodo, uint32_t atraso = 0) {
+    if (agendaTam + agendaFora >= AGENDA_MAX) return false;
+    agenda[agendaTam] = { (uint32_t)millis() + atraso, periodo, f };
+    agendaSubir(agendaTam++);
+    return true;
+}
+
+void tarefaAgenda(void*) {
+    for (;;) {
+        if (agendaTam == 0) { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); continue; }
+        uint32_t agora = millis();
+        int32_t  falta = (int32_t)(agenda[0].prazo - agora);
+        if (falta > 0) { ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(falta)); continue; }
+
+        // retira do heap antes de rodar: um agendar() dentro de f() pode
+        // mudar a raiz
+        Evento ev = agenda[0];
+        agenda[0] = agenda[--agendaTam];
+        agendaDescer(0);
+        agendaFora = 1;
+        ev.f();
+        agendaFora = 0;
+
+        // próximo prazo sem deriva; se atrasou um período inteiro, recomeça de agora
+        ev.prazo += ev.periodo;
+        if ((int32_t)(ev.prazo - agora) <= 0) ev.prazo = agora + ev.periodo;
+        agenda[agendaTam] = ev;
+        agendaSubir(agendaTam++);
+    }
+}
+
 // ══════════════════════════════════════════════════════════
 //  SENSORES
 // ══════════════════════════════════════════════════════════
-void lerSensores() {
-    float t = dht.readTemperature();
-    float h = dht.readHumidity();
-    if (!isnan(t)) temperatura = t;
-    if (!isnan(h)) umidade     = h;
+//  Lux do LDR: tabela de 4096 entradas montada no boot (a curva
+//  do ADC vem do eFuse, então não dá para ser constexpr).
+//    V    = cal(adc)
+//    R    = R_FIXO · (VCC − V) / V
+//    lux  = 10 · (R_10LUX / R)^(1/γ)
+//  Sem heap para a tabela, cada leitura faz a conta (um powf).
+uint16_t* tabelaLux = nullptr;   // 4096 entradas (8 KB); satura em 65535 lux
+
+uint16_t luxCalcular(int adc) {
+    float mv = (float)halAdcMilivolts(adc);
+    if (mv <= 0)           return 0;
+    if (mv >= LDR_VCC_MV)  return 65535;
+    float r   = LDR_R_FIXO * (LDR_VCC_MV - mv) / mv;
+    float lux = 10.0f * powf(LDR_R_10LUX / r, 1.0f / LDR_GAMA);
+    return lux >= 65535.0f ? 65535 : (uint16_t)lroundf(lux);
+}
+
+void luxIniciar() {
+    if (!tabelaLux) return;
+    for (int adc = 0; adc < 4096; adc++) tabelaLux[adc] = luxCalcular(adc);
+}
+
+void lerSensores(Amostra& a) {
+    a.dht  = halLerDHT();
+    int adc = constrain(halLerLDR(), 0, 4095);
+    a.luz  = constrain(map(adc, 0, 4095, 0, 100), 0, 100);   // % – limiares e interface
+    a.lux  = tabelaLux ? tabelaLux[adc] : luxCalcular(adc);
+    a.adc  = adc;
+    a.adcBrutoQ4 = constrain(halLdrBrutoQ4(), 0, 4095 << 4);
+    a.t_us = halMicros();
+}
+
+/** Evento da agenda (a cada PERIODO_AMOSTRA_MS): lê e entrega a amostra ao controle */
+void eventoAmostrar() {
+    MsgControle m;
+    m.tipo = MSG_AMOSTRA;
+    lerSensores(m.amostra);
+    if (xQueueSend(filaControle, &m, 0) != pdTRUE) amostrasPerdidas++;
+}
+
+// ══════════════════════════════════════════════════════════
+//  SAÚDE DOS SENSORES
+//  A tarefa de controle avalia cada transação nova: leitura
+//  aceita, falha, salto implausível ou valor congelado. Se o
+//  DHT22 ou o LDR ficarem velhos, travados ou com saltos
+//  seguidos (saudeDegradada()), controlar() troca a histérese
+//  por uma política segura (modo degradado).
+// ══════════════════════════════════════════════════════════
+/**
+ * Registra uma leitura (lida = o driver entregou um valor). Retorna
+ * true se o valor pode ser usado. Um salto maior que dMax é rejeitado,
+ * a menos que se repita SAUDE_IMPLAUSIVEL_MAX vezes (novo patamar).
+ */
+bool saudeAvaliar(SaudeCanal& s, uint32_t t, bool lida, float a, float b,
+                  float dMaxA, float dMaxB, bool checarTravado) {
+    bool salto = lida && s.temValor && s.falhasSeguidas < SAUDE_IMPLAUSIVEL_MAX &&
+                 (fabsf(a - s.a) > dMaxA || fabsf(b - s.b) > dMaxB);
+    if (!lida || salto) {
+        s.falhasSeguidas++;
+        if (t - s.ultimoBom > SAUDE_VELHO_S) s.estado = SAUDE_VELHO;
+        else if (salto)                       s.estado = SAUDE_IMPLAUSIVEL;
+        return false;
+    }
+
+    if (!s.temValor || a != s.a || b != s.b) s.inicioIgual = t;
+    s.a = a;  s.b = b;  s.temValor = true;
+    s.ultimoBom      = t;
+    s.falhasSeguidas = 0;
+    s.estado = checarTravado && t - s.inicioIgual >= SAUDE_TRAVADO_S ? SAUDE_TRAVADO : SAUDE_OK;
+    return true;
+}
+
+/** Sem transação nova também envelhece (driver parado, sensor solto) */
+void saudeEnvelhecer(SaudeCanal& s, uint32_t t) {
+    if (t - s.ultimoBom > SAUDE_VELHO_S) s.estado = SAUDE_VELHO;
+}
+
+/**
+ * Estados que tiram o canal da histérese. Um salto isolado só é
+ * descartado – o controle segue no último valor bom – e passa a contar
+ * depois de SAUDE_IMPLAUSIVEL_MAX rejeições seguidas.
+ */
+bool saudeDegradada(uint8_t estado, uint16_t seguidas) {
+    return estado == SAUDE_VELHO || estado == SAUDE_TRAVADO ||
+           (estado == SAUDE_IMPLAUSIVEL && seguidas >= SAUDE_IMPLAUSIVEL_MAX);
+}
+
+// ══════════════════════════════════════════════════════════
+//  HISTÓRICO – anel de blocos com deltas de tamanho variável
+// ══════════════════════════════════════════════════════════
+//  Cada bloco guarda a 1ª amostra inteira (décimos de °C, décimos
+//  de %, % de luz) e as seguintes como deltas, por canal:
+//     0            → Δ = 0          (1 bit)
+//     10 s         → Δ = ±1         (3 bits)
+//     11 s mmm     → Δ = ±(2..9)    (6 bits)
+//  Salto maior, buraco no tempo ou bloco cheio abrem bloco novo.
+struct BlocoHist {
+    uint32_t t0;                        // segundo (desde o boot) da 1ª amostra
+    int16_t  temp0, umid0;              // décimos
+    uint8_t  luz0;
+    uint8_t  n;                         // amostras no bloco (1..HIST_AMOSTRAS_BLOCO)
+    uint8_t  bits;                      // bits ocupados em dados
+    uint8_t  _res;
+    uint8_t  dados[HIST_DADOS_BYTES];
+};
+
+BlocoHist*   hist      = nullptr;       // anel de histCap blocos (heap, ver alocarMemoria())
+uint16_t     histCap   = HIST_BLOCOS;
+uint32_t     histTotal = 0;             // blocos já abertos desde o boot
+portMUX_TYPE muxHist   = portMUX_INITIALIZER_UNLOCKED;
+
+// último valor gravado (só a tarefa de controle usa)
+int16_t histUltT, histUltU;
+uint8_t histUltL;
+
+/** bits para codificar um delta; 0 = não cabe */
+uint8_t histTamDelta(int d) {
+    if (d == 0)            return 1;
+    if (d == 1 || d == -1) return 3;
+    if (d >= -9 && d <= 9) return 6;
+    return 0;
+}
+
+void histPorBits(uint8_t* dados, uint8_t& pos, uint8_t valor, uint8_t n) {
+    while (n--) {
+        if ((valor >> n) & 1) dados[pos >> 3] |= 0x80 >> (pos & 7);
+        pos++;
+    }
+}
+
+uint8_t histTirarBits(const uint8_t* dados, uint8_t& pos, uint8_t n) {
+    uint8_t v = 0;
+    while (n--) {
+        v = (v << 1) | ((dados[pos >> 3] >> (7 - (pos & 7))) & 1);
+        pos++;
+    }
+    return v;
+}
+
+void histPorDelta(uint8_t* dados, uint8_t& pos, int d) {
+    if (d == 0) { histPorBits(dados, pos, 0, 1); return; }
+    uint8_t sinal = d < 0;
+    uint8_t m     = d < 0 ? -d : d;
+    if (m == 1) { histPorBits(dados, pos, 0b10, 2); histPorBits(dados, pos, sinal, 1); return; }
+    histPorBits(dados, pos, 0b11, 2);
+    histPorBits(dados, pos, sinal, 1);
+    histPorBits(dados, pos, m - 2, 3);
+}
+
+int histTirarDelta(const uint8_t* dados, uint8_t& pos) {
+    if (!histTirarBits(dados, pos, 1)) return 0;
+    bool    grande = histTirarBits(dados, pos, 1);
+    bool    neg    = histTirarBits(dados, pos, 1);
+    int     m      = grande ? histTirarBits(dados, pos, 3) + 2 : 1;
+    return neg ? -m : m;
+}
+
+// ══════════════════════════════════════════════════════════
+//  RESUMOS – camadas de 1 min e 1 h atualizadas a cada amostra
+// ══════════════════════════════════════════════════════════
+//  Cada camada fecha um Resumo quando o período vira; consultas
+//  longas leem poucos resumos em vez de milhares de amostras.
+struct Resumo {
+    uint32_t t0;                     // início do período (alinhado)
+    int16_t  tMin, tMed, tMax;       // décimos de °C
+    int16_t  uMin, uMed, uMax;       // décimos de %
+    uint8_t  lMin, lMed, lMax;       // %
+    uint8_t  _res;
+    uint16_t n;                      // amostras no período
+    uint16_t lampOn, motOn;          // amostras com o relé ligado (duty = on / n)
+};
+
+/** min/soma/máx em andamento – usado pelas camadas e pelos baldes de /api/history */
+struct AcumHist {
+    uint32_t inicio;
+    uint32_t n, lampOn, motOn;
+    int16_t  tMin, tMax, uMin, uMax;
+    uint8_t  lMin, lMax;
+    int32_t  tSoma, uSoma, lSoma;
+};
+
+struct CamadaResumo {
+    Resumo*  anel;
+    uint16_t cap;
+    uint32_t periodo;                // s
+    uint32_t total;                  // resumos fechados desde o boot
+    AcumHist acum;                   // período em andamento
+};
+
+// anel e cap definidos em alocarMemoria(); cap 0 = camada desligada
+CamadaResumo camadaMin  = { nullptr, RESUMO_MIN_CAP,  60,   0, {} };
+CamadaResumo camadaHora = { nullptr, RESUMO_HORA_CAP, 3600, 0, {} };
+
+long mediaArred(int32_t soma, uint32_t n) {
+    return soma >= 0 ? (soma + (int32_t)n / 2) / (int32_t)n : (soma - (int32_t)n / 2) / (int32_t)n;
+}
+
+void acumZerar(AcumHist& a, uint32_t inicio) {
+    a.inicio = inicio;  a.n = a.lampOn = a.motOn = 0;
+    a.tMin = a.uMin = INT16_MAX;  a.tMax = a.uMax = INT16_MIN;
+    a.lMin = 255;  a.lMax = 0;
+    a.tSoma = a.uSoma = a.lSoma = 0;
+}
+
+void acumSomar(AcumHist& a, int16_t t, int16_t u, uint8_t l, bool lamp, bool mot) {
+    a.n++;  a.lampOn += lamp;  a.motOn += mot;
+    a.tMin = min(a.tMin, t);   a.tMax = max(a.tMax, t);   a.tSoma += t;
+    a.uMin = min(a.uMin, u);   a.uMax = max(a.uMax, u);   a.uSoma += u;
+    a.lMin = min(a.lMin, l);   a.lMax = max(a.lMax, l);   a.lSoma += l;
+}
+
+void acumSomarResumo(AcumHist& a, const Resumo& r) {
+    a.n += r.n;  a.lampOn += r.lampOn;  a.motOn += r.motOn;
+    a.tMin = min(a.tMin, r.tMin);   a.tMax = max(a.tMax, r.tMax);   a.tSoma += (int32_t)r.tMed * r.n;
+    a.uMin = min(a.uMin, r.uMin);   a.uMax = max(a.uMax, r.uMax);   a.uSoma += (int32_t)r.uMed * r.n;
+    a.lMin = min(a.lMin, r.lMin);   a.lMax = max(a.lMax, r.lMax);   a.lSoma += (int32_t)r.lMed * r.n;
+}
+
+Resumo acumFechar(const AcumHist& a) {
+    Resumo r;
+    r.t0   = a.inicio;
+    r.tMin = a.tMin;  r.tMed = mediaArred(a.tSoma, a.n);  r.tMax = a.tMax;
+    r.uMin = a.uMin;  r.uMed = mediaArred(a.uSoma, a.n);  r.uMax = a.uMax;
+    r.lMin = a.lMin;  r.lMed = mediaArred(a.lSoma, a.n);  r.lMax = a.lMax;
+    r._res = 0;
+    r.n = a.n;  r.lampOn = a.lampOn;  r.motOn = a.motOn;
+    return r;
+}
+
+/** O(1): soma no período corrente e fecha o anterior se o período virou */
+void camadaRegistrar(CamadaResumo& c, uint32_t t, int16_t qt, int16_t qu, uint8_t ql,
+                     bool lamp, bool mot) {
+    if (!c.cap) return;
+    uint32_t inicio = t / c.periodo * c.periodo;
+    if (c.acum.n && inicio != c.acum.inicio) {
+        c.anel[c.total % c.cap] = acumFechar(c.acum);
+        c.total++;
+        c.acum.n = 0;
+    }
+    if (!c.acum.n) acumZerar(c.acum, inicio);
+    acumSomar(c.acum, qt, qu, ql, lamp, mot);
+}
+
+/** i-ésimo resumo mais antigo; i == nº de fechados devolve o período em andamento */
+bool camadaCopiar(const CamadaResumo& c, uint32_t i, Resumo& out) {
+    bool ok = true;
+    portENTER_CRITICAL(&muxHist);
+    uint32_t vivos = c.total < c.cap ? c.total : c.cap;
+    if (i < vivos)                    out = c.anel[(c.total - vivos + i) % c.cap];
+    else if (i == vivos && c.acum.n)  out = acumFechar(c.acum);
+    else                              ok = false;
+    portEXIT_CRITICAL(&muxHist);
+    return ok;
+}
+
+/** Primeiro resumo (índice lógico) cujo período termina depois de 'de' */
+uint32_t camadaBuscar(const CamadaResumo& c, uint32_t de) {
+    portENTER_CRITICAL(&muxHist);
+    uint32_t hi = (c.total < c.cap ? c.total : c.cap) + 1;
+    portEXIT_CRITICAL(&muxHist);
+    uint32_t lo = 0;
+    Resumo r;
+    while (lo < hi) {
+        uint32_t meio = (lo + hi) / 2;
+        if (!camadaCopiar(c, meio, r)) { hi = meio; continue; }
+        if (r.t0 + c.periodo <= de) lo = meio + 1; else hi = meio;
+    }
+    return lo;
+}
+
+/** Acrescenta uma amostra ao anel e às camadas – O(1), chamada pela tarefa de controle */
+void historicoRegistrar(uint32_t t, float temp, float umid, int luz, bool lamp, bool mot) {
+    int16_t qt = (int16_t)lroundf(temp * 10.0f);
+    int16_t qu = (int16_t)lroundf(umid * 10.0f);
+    uint8_t ql = (uint8_t)constrain(luz, 0, 255);
+
+    portENTER_CRITICAL(&muxHist);
+    camadaRegistrar(camadaMin,  t, qt, qu, ql, lamp, mot);
+    camadaRegistrar(camadaHora, t, qt, qu, ql, lamp, mot);
+    if (!histCap) { portEXIT_CRITICAL(&muxHist); return; }
+
+    BlocoHist& b = hist[(histTotal + histCap - 1) % histCap];
+    bool novo = (histTotal == 0) || b.n >= HIST_AMOSTRAS_BLOCO;
+    if (!novo) {
+        // amostras implícitas a cada 1 s; tolera ±1 s de arredondamento
+        int32_t desvio = (int32_t)(t - (b.t0 + b.n));
+        int dt = qt - histUltT, du = qu - histUltU, dl = ql - histUltL;
+        uint8_t at = histTamDelta(dt), au = histTamDelta(du), al = histTamDelta(dl);
+        novo = desvio < -1 || desvio > 1 || !at || !au || !al ||
+               b.bits + at + au + al > HIST_DADOS_BYTES * 8;
+        if (!novo) {
+            histPorDelta(b.dados, b.bits, dt);
+            histPorDelta(b.dados, b.bits, du);
+            histPorDelta(b.dados, b.bits, dl);
+            b.n++;
+        }
+    }
+    if (novo) {
+        BlocoHist& nb = hist[histTotal % histCap];
+        memset(&nb, 0, sizeof(nb));
+        nb.t0 = t;  nb.temp0 = qt;  nb.umid0 = qu;  nb.luz0 = ql;  nb.n = 1;
+        histTotal++;
+    }
+    histUltT = qt;  histUltU = qu;  histUltL = ql;
+    portEXIT_CRITICAL(&muxHist);
+}
+
+/** Copia o i-ésimo bloco mais antigo ainda no anel; false se não existe */
+bool historicoCopiarBloco(uint32_t i, BlocoHist& out) {
+    bool ok;
+    portENTER_CRITICAL(&muxHist);
+    uint32_t total = histTotal;
+    uint32_t vivos = total < histCap ? total : histCap;
+    ok = i < vivos;
+    if (ok) out = hist[(total - vivos + i) % histCap];
+    portEXIT_CRITICAL(&muxHist);
+    return ok;
+}
+
+uint32_t historicoBlocosVivos() {
+    portENTER_CRITICAL(&muxHist);
+    uint32_t vivos = histTotal < histCap ? histTotal : histCap;
+    portEXIT_CRITICAL(&muxHist);
+    return vivos;
+}
+
+/**
+ * Reserva um anel de até 'cap' elementos no heap interno sem deixar
+ * menos de MEMORIA_RESERVA livre; não cabendo, tenta com a metade.
+ * Devolve nullptr com cap = 0 se nem 'minimo' couber.
+ */
+template <typename T>
+T* alocarAnel(uint16_t& cap, uint16_t minimo) {
+    for (; cap >= minimo && cap > 0; cap /= 2) {
+        size_t bytes = (size_t)cap * sizeof(T);
+        if (heap_caps_get_free_size(MALLOC_CAP_INTERNAL) < bytes + MEMORIA_RESERVA) continue;
+        void* p = heap_caps_calloc(cap, sizeof(T), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (p) return (T*)p;
+    }
+    cap = 0;
+    return nullptr;
+}
+
+/**
+ * Tabela de lux e anéis de histórico no heap, em ordem de utilidade.
+ * Chamada no setup() depois do WiFi no ar (o AP já pegou os buffers
+ * dele) e antes de qualquer tarefa tocar nesses dados.
+ */
+void alocarMemoria() {
+    Serial.printf("[MEM] livre %u B, maior bloco %u B\n",
+                  (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+                  (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL));
+    uint16_t capLux = 4096;
+    tabelaLux       = alocarAnel<uint16_t>(capLux, 4096);
+    camadaHora.anel = alocarAnel<Resumo>(camadaHora.cap, 24);   // ao menos 1 dia
+    hist            = alocarAnel<BlocoHist>(histCap, 16);
+    camadaMin.anel  = alocarAnel<Resumo>(camadaMin.cap, 60);    // ao menos 1 h
+    luxIniciar();
+    Serial.printf("[MEM] lux %s, hist %u blocos, resumos %u min / %u h; sobram %u B\n",
+                  tabelaLux ? "tabela" : "calculado", histCap,
+                  camadaMin.cap, camadaHora.cap,
+                  (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+}
+
+// ══════════════════════════════════════════════════════════
+//  LOG PERSISTENTE – segmentos só-anexa no LittleFS
+// ══════════════════════════════════════════════════════════
+//  Registro binário de 16 bytes, little-endian (formato do /api/log):
+//    u32 boot | u32 t (s desde o boot) | u8 tipo | u8 relés (b0 lâmp, b1 motor)
+//    i16 temp (décimos °C) | i16 umid (décimos %) | u8 luz (%) | u8 CRC-8
+//  (temp/umid = INT16_MIN: relé trocou antes da 1ª leitura do DHT22)
+//  Leituras entram como média de cada minuto fechado; transições de
+//  relé entram na hora. A tarefa de log junta registros e grava quando
+//  a página enche, a cada LOG_FLUSH_MS ou logo após uma transição de
+//  relé: numa queda de energia perde-se no máximo 1 min de leituras e
+//  nenhuma troca de relé. São ~1500 anexos por dia no pior caso – o
+//  LittleFS espalha o desgaste pela partição.
+enum TipoRegistro : uint8_t { REG_LEITURA = 1, REG_RELE = 2 };
+
+struct RegistroLog {
+    uint32_t boot;
+    uint32_t t;
+    uint8_t  tipo;
+    uint8_t  reles;
+    int16_t  temp;
+    int16_t  umid;
+    uint8_t  luz;
+    uint8_t  crc;
+};
+static_assert(sizeof(RegistroLog) == 16, "RegistroLog deve ter 16 bytes");
+
+QueueHandle_t filaLog;
+bool          logAtivo        = false;
+uint32_t      logBoot         = 1;   // definido na varredura de boot
+uint32_t      logSeqPrimeiro  = 0;   // segmento mais antigo no disco
+uint32_t      logSeqAtual     = 0;   // segmento recebendo anexos
+uint32_t      logSegTam       = 0;
+uint32_t      logDescartados  = 0;   // fila cheia
+
+uint8_t crc8(const uint8_t* p, size_t n) {
+    uint8_t c = 0;
+    while (n--) {
+        c ^= *p++;
+        for (int i = 0; i < 8; i++) c = (c & 0x80) ? (c << 1) ^ 0x07 : c << 1;
+    }
+    return c;
+}
+
+void logNomeSegmento(char* nome, size_t cap, uint32_t seq) {
+    snprintf(nome, cap, LOG_DIR "/%08lu.bin", (unsigned long)seq);
+}
+
+/** Monta e enfileira um registro; nunca bloqueia (chamada pela tarefa de controle) */
+void logEnfileirar(TipoRegistro tipo, uint32_t t, int16_t temp, int16_t umid, uint8_t luz,
+                   bool lamp, bool mot) {
+    if (!logAtivo) return;
+    RegistroLog r;
+    r.boot  = logBoot;   r.t    = t;      r.tipo = tipo;
+    r.reles = (lamp ? 1 : 0) | (mot ? 2 : 0);
+    r.temp  = temp;      r.umid = umid;   r.luz  = luz;
+    r.crc   = crc8((const uint8_t*)&r, sizeof(r) - 1);
+    if (xQueueSend(filaLog, &r, 0) != pdTRUE) logDescartados++;
+}
+
+/** Anexa uma página ao segmento atual e gira/apaga segmentos quando preciso */
+void logGravar(const uint8_t* dados, size_t n) {
+    char nome[24];
+    logNomeSegmento(nome, sizeof(nome), logSeqAtual);
+    File f = LittleFS.open(nome, "a");
+    if (!f) { Serial.println("[LOG] falha ao abrir " + String(nome)); return; }
+    f.write(dados, n);
+    f.close();
+
+    logSegTam += n;
+    if (logSegTam >= LOG_SEGMENTO_MAX) {
+        logSeqAtual++;
+        logSegTam = 0;
+        while (logSeqAtual - logSeqPrimeiro >= LOG_SEGMENTOS_MAX) {
+            logNomeSegmento(nome, sizeof(nome), logSeqPrimeiro);
+            LittleFS.remove(nome);
+            logSeqPrimeiro++;
+        }
+    }
+}
+
+/** Bytes do início de p (n bytes) cobertos por registros inteiros com CRC certo */
+size_t logPrefixoValido(const uint8_t* p, size_t n) {
+    size_t ok = 0;
+    for (; ok + sizeof(RegistroLog) <= n; ok += sizeof(RegistroLog))
+        if (p[ok + sizeof(RegistroLog) - 1] != crc8(p + ok, sizeof(RegistroLog) - 1)) break;
+    return ok;
+}
+
+/**
+ * Varredura de boot: acha o intervalo de segmentos, valida o último
+ * registro a registro (CRC) e descobre o nº do boot anterior. Se o fim
+ * do segmento estiver corrompido (queda de energia no meio de uma
+ * gravação), os anexos seguem num segmento novo; o resto rasgado fica
+ * no disco, mas /api/log para no 1º registro inválido de cada segmento.
+ */
+bool iniciarLog() {
+    if (!LittleFS.begin(true)) { Serial.println("[LOG] LittleFS indisponivel – log desativado"); return false; }
+    if (!LittleFS.exists(LOG_DIR)) LittleFS.mkdir(LOG_DIR);
+
+    uint32_t menor = UINT32_MAX, maior = 0;
+    File dir = LittleFS.open(LOG_DIR);
+    for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+        const char* nome  = strrchr(f.name(), '/');
+        uint32_t    seq   = strtoul(nome ? nome + 1 : f.name(), nullptr, 10);
+        if (seq < menor) menor = seq;
+        if (seq > maior) maior = seq;
+    }
+
+    uint32_t bootAnterior = 0, validos = 0;
+    if (menor != UINT32_MAX) {
+        logSeqPrimeiro = menor;
+        logSeqAtual    = maior;
+
+        char nome[24];
+        logNomeSegmento(nome, sizeof(nome), maior);
+        File f = LittleFS.open(nome, "r");
+        size_t      tam = f.size();
+        RegistroLog r;
+        while (f.read((uint8_t*)&r, sizeof(r)) == sizeof(r) &&
+               r.crc == crc8((const uint8_t*)&r, sizeof(r) - 1)) {
+            bootAnterior = r.boot;
+            validos++;
+        }
+        f.close();
+
+        logSegTam = validos * sizeof(RegistroLog);
+        if (logSegTam != tam || logSegTam >= LOG_SEGMENTO_MAX) { logSeqAtual++; logSegTam = 0; }
+    }
+    logBoot = bootAnterior + 1;
 
-    int adc = analogRead(PIN_LDR);
-    pctLuz  = constrain(map(adc, 0, 4095, 0, 100), 0, 100);
+    filaLog  = xQueueCreate(LOG_FILA_TAM, sizeof(RegistroLog));
+    logAtivo = true;
+    Serial.println("[LOG] segmentos " + String(logSeqPrimeiro) + ".." + String(logSeqAtual) +
+                   ", " + String(validos) + " registros validos no ultimo, boot #" + String(logBoot));
+    return true;
+}
+
+/** Junta registros numa página em RAM e grava quando enche, a cada LOG_FLUSH_MS ou numa troca de relé */
+void tarefaLog(void*) {
+    static uint8_t pagina[LOG_PAGINA];
+    size_t         usados     = 0;
+    bool           temRele    = false;   // página tem transição de relé ainda fora da flash
+    TickType_t     ultimaGrav = xTaskGetTickCount();
+    for (;;) {
+        TickType_t decorrido = xTaskGetTickCount() - ultimaGrav;
+        TickType_t espera    = decorrido < pdMS_TO_TICKS(LOG_FLUSH_MS)
+                             ? pdMS_TO_TICKS(LOG_FLUSH_MS) - decorrido : 0;
+        RegistroLog r;
+        if (xQueueReceive(filaLog, &r, espera) == pdTRUE) {
+            memcpy(pagina + usados, &r, sizeof(r));
+            usados  += sizeof(r);
+            temRele |= r.tipo == REG_RELE;
+        }
+        bool cheia  = usados + sizeof(r) > LOG_PAGINA;
+        bool venceu = xTaskGetTickCount() - ultimaGrav >= pdMS_TO_TICKS(LOG_FLUSH_MS);
+        bool rele   = temRele && !uxQueueMessagesWaiting(filaLog);   // uma rajada vira uma gravação
+        if (cheia || venceu || rele) {
+            if (usados) logGravar(pagina, usados);
+            usados     = 0;
+            temRele    = false;
+            ultimaGrav = xTaskGetTickCount();
+        }
+    }
 }
 
 // ══════════════════════════════════════════════════════════
 //  ATUADORES  (lógica com histérese)
 // ══════════════════════════════════════════════════════════
 void controlar() {
+    uint32_t t = halSegundos();
+    bool querLamp, querMot;
     if (modoManual) {
-        lampada = lampManual;
-        motor   = motManual;
+        querLamp = lampManual;
+        querMot  = motManual;
     } else {
-        // Motor – liga por temperatura OU umidade (histérese dupla)
-        if (!motor  && (temperatura > cfg_tempLigar  || umidade > cfg_umidLigar ))  motor  = true;
-        if ( motor  && (temperatura < cfg_tempDeslig && umidade < cfg_umidDeslig))  motor  = false;
+        Limiares c = { cfg_tempLigar, cfg_tempDeslig, cfg_umidLigar, cfg_umidDeslig,
+                       cfg_luzLigar,  cfg_luzDeslig };
+        querLamp = lampada;
+        querMot  = motor;
+        decidirReles(c, temperatura, umidade, pctLuz, querLamp, querMot);
+
+        // modo degradado: não decide em cima de valor velho ou congelado
+        if (saudeDegradada(saudeDht.estado, saudeDht.falhasSeguidas))
+            querMot  = t % DEGRADADO_CICLO_S < DEGRADADO_MOTOR_S;
+        if (saudeDegradada(saudeLdr.estado, saudeLdr.falhasSeguidas))
+            querLamp = false;
+    }
+
+    // a proteção decide se a troca sai agora; GPIO só nas transições
+    if (releAplicar(reles[RELE_LAMPADA], LIMITES_RELE[RELE_LAMPADA], querLamp, t))
+        halRele(RELE_LAMPADA, querLamp);
+    if (releAplicar(reles[RELE_MOTOR], LIMITES_RELE[RELE_MOTOR], querMot, t))
+        halRele(RELE_MOTOR, querMot);
+    lampada = reles[RELE_LAMPADA].ligado;
+    motor   = reles[RELE_MOTOR].ligado;
+}
+
+/** Aplica um pedido às variáveis de estado (só na tarefa de controle) */
+void aplicarMsg(const MsgControle& m) {
+    switch (m.tipo) {
+        case MSG_AMOSTRA: {
+            const AmostraDHT& d = m.amostra.dht;
+            uint32_t t = halSegundos();
+            if (d.t_ms != dhtUltimaTrans) {   // transação nova (não repetida)
+                dhtUltimaTrans = d.t_ms;
+                dhtStatus      = d.status;
+                dhtContagem[dhtStatus]++;
+                if (saudeAvaliar(saudeDht, t, d.status == DHT_OK, d.temp, d.umid,
+                                 SAUDE_DTEMP_MAX, SAUDE_DUMID_MAX, true)) {
+                    temperatura = d.temp;
+                    umidade     = d.umid;
+                    tempMinDia  = fminf(tempMinDia, d.temp);   // fminf/fmaxf ignoram o NaN inicial
+                    tempMaxDia  = fmaxf(tempMaxDia, d.temp);
+                    umidMinDia  = fminf(umidMinDia, d.umid);
+                    umidMaxDia  = fmaxf(umidMaxDia, d.umid);
+                }
+            }
+            saudeEnvelhecer(saudeDht, t);
+
+            // LDR não tem falha de leitura; só o congelamento interessa. Vale
+            // a média crua do bloco em Q4: o valor filtrado fica parado numa
+            // cena constante, o ruído do ADC não. Os extremos são normais no
+            // escuro total ou com o ADC saturado
+            bool extremo = m.amostra.adc == 0 || m.amostra.adc == 4095;
+            saudeAvaliar(saudeLdr, t, true, m.amostra.adcBrutoQ4, 0, INFINITY, INFINITY, !extremo);
+            pctLuz = m.amostra.luz;
+            lux    = m.amostra.lux;
+            break;
+        }
+        case MSG_MODO:
+            if (m.manual && !modoManual) {
+                // entrando no modo manual: captura estados atuais dos relés
+                lampManual = lampada;
+                motManual  = motor;
+            }
+            modoManual = m.manual;
+            break;
+        case MSG_RELE:
+            if (!modoManual) break;   // modo pode ter mudado desde o pedido
+            if (m.rele.canal == 0) lampManual = m.rele.ligado;
+            if (m.rele.canal == 1) motManual  = m.rele.ligado;
+            break;
+        case MSG_CONFIG:
+            cfg_tempLigar  = m.cfg.tempLigar;   cfg_tempDeslig = m.cfg.tempDeslig;
+            cfg_umidLigar  = m.cfg.umidLigar;   cfg_umidDeslig = m.cfg.umidDeslig;
+            cfg_luzLigar   = m.cfg.luzLigar;    cfg_luzDeslig  = m.cfg.luzDeslig;
+            break;
+    }
+}
 
-        // Lâmpada – liga quando ambiente escuro
-        if (!lampada && pctLuz < cfg_luzLigar )  lampada = true;
-        if ( lampada && pctLuz > cfg_luzDeslig)  lampada = false;
+/**
+ * Vira o dia se preciso e soma ao tempo ligado o intervalo desde a
+ * última mensagem – os relés ficaram no estado atual durante ele.
+ */
+void estatDiaAvancar(uint32_t t) {
+    if (t / 86400 != diaAtual) {
+        diaAtual   = t / 86400;
+        tempMinDia = tempMaxDia = umidMinDia = umidMaxDia = NAN;
+        lampSegDia = motSegDia = 0;
+    } else {
+        uint32_t dt = t - tUltimaMsg;
+        if (lampada) lampSegDia += dt;
+        if (motor)   motSegDia  += dt;
     }
+    tUltimaMsg = t;
+}
 
-    // Active LOW: LOW = ligado
-    digitalWrite(PIN_RELAY_LAMPADA, lampada ? LOW : HIGH);
-    digitalWrite(PIN_RELAY_MOTOR,   motor   ? LOW : HIGH);
+/**
+ * Única tarefa que escreve no estado. Dorme na fila até chegar uma
+ * amostra ou um pedido da web, aplica e decide os relés na hora.
+ */
+void tarefaControle(void*) {
+    MsgControle m;
+    uint32_t    minutosLogados = 0;
+    for (;;) {
+        if (xQueueReceive(filaControle, &m, portMAX_DELAY) != pdTRUE) continue;
+        uint32_t t = halSegundos();
+        bool lampAntes = lampada, motAntes = motor;
+        estatDiaAvancar(t);
+        aplicarMsg(m);
+        controlar();
+        if (publicarEstado() && displayTarefa) xTaskNotifyGive(displayTarefa);   // LCD pode estar sujo
+
+        if (lampada != lampAntes || motor != motAntes)
+            logEnfileirar(REG_RELE, t,
+                          saudeDht.temValor ? lroundf(temperatura * 10.0f) : INT16_MIN,
+                          saudeDht.temValor ? lroundf(umidade * 10.0f)     : INT16_MIN,
+                          pctLuz, lampada, motor);
+
+        if (m.tipo == MSG_AMOSTRA) {
+            uint32_t lat = halMicros() - m.amostra.t_us;
+            if (lat > latenciaMaxUs) latenciaMaxUs = lat;
+            latenciaFaixas[min(31 - __builtin_clz(lat | 1), LAT_FAIXAS - 1)]++;
+
+            if (saudeDht.temValor)   // antes da 1ª leitura não há o que guardar
+                historicoRegistrar(t, temperatura, umidade, pctLuz, lampada, motor);
+
+            // cada minuto fechado vira um registro de leitura no log
+            // (esta tarefa é a escritora das camadas – lê sem trava)
+            if (camadaMin.total != minutosLogados) {
+                minutosLogados = camadaMin.total;
+                const Resumo& r = camadaMin.anel[(camadaMin.total - 1) % camadaMin.cap];
+                logEnfileirar(REG_LEITURA, r.t0, r.tMed, r.uMed, r.lMed,
+                              r.lampOn * 2 > r.n, r.motOn * 2 > r.n);
+            }
+        }
+    }
+}
+
+/**
+ * Percentil pct (0–100) de um histograma de latência, como o limite
+ * superior da faixa em que ele cai (µs); 0 se não há amostras.
+ */
+uint32_t latenciaPercentil(const uint32_t* faixas, uint8_t pct) {
+    uint64_t total = 0, soma = 0;
+    for (int k = 0; k < LAT_FAIXAS; k++) total += faixas[k];
+    if (!total) return 0;
+    uint64_t alvo = (total * pct + 99) / 100;
+    for (int k = 0; k < LAT_FAIXAS - 1; k++) {
+        soma += faixas[k];
+        if (soma >= alvo) return 2UL << k;
+    }
+    return 2UL << (LAT_FAIXAS - 1);
+}
+
+/** Envia um pedido da web ao controle; false se a fila continuar cheia */
+bool enviarControle(const MsgControle& m) {
+    return xQueueSend(filaControle, &m, pdMS_TO_TICKS(50)) == pdTRUE;
+}
+
+// ══════════════════════════════════════════════════════════
+//  LCD – framebuffer sombra
+//  As telas desenham em lcdQuadro; lcdAtualizar() compara com
+//  lcdVidro (o que o display mostra) e só envia as células que
+//  mudaram. Um trecho sujo é escrito de uma vez (o cursor do
+//  HD44780 avança sozinho) e um buraco de 1 célula limpa é
+//  reescrito em vez de pagar um setCursor.
+// ══════════════════════════════════════════════════════════
+char     lcdQuadro[LCD_LINHAS][LCD_COLUNAS];
+char     lcdVidro[LCD_LINHAS][LCD_COLUNAS];
+uint8_t  lcdCurCol = 0xFF, lcdCurLin = 0xFF;   // posição do cursor no display (0xFF = desconhecida)
+
+uint32_t lcdFlushes  = 0;   // contadores para /api/lcd
+uint32_t lcdCelulas  = 0;
+uint32_t lcdCursores = 0;
+
+/**
+ * Começa uma linha do quadro a partir de um modelo (corta em 16,
+ * completa com espaços) e devolve a linha para os lcdCampo*().
+ */
+char* lcdLinha(uint8_t linha, const char* modelo) {
+    char*  l = lcdQuadro[linha];
+    size_t n = strnlen(modelo, LCD_COLUNAS);
+    memcpy(l, modelo, n);
+    memset(l + n, ' ', LCD_COLUNAS - n);
+    return l;
+}
+
+// ── campos de largura fixa: nada de String, nada de heap ──────
+//  Cada tela é um modelo constante com buracos em colunas fixas;
+//  os números ficam sempre no mesmo lugar, então o diff do
+//  framebuffer só reenvia os dígitos que mudaram.
+
+/** Copia os dígitos de v para o fim de tmp; devolve o índice do 1º caractere */
+int lcdDigitos(char (&tmp)[12], long v) {
+    int i = sizeof(tmp);
+    unsigned long u = (v < 0) ? 0UL - (unsigned long)v : (unsigned long)v;
+    do { tmp[--i] = '0' + (u % 10); u /= 10; } while (u);
+    if (v < 0) tmp[--i] = '-';
+    return i;
+}
+
+/** Texto pronto alinhado à direita em [col, col+larg); se não couber, '*' */
+void lcdCampoDireita(char* l, uint8_t col, uint8_t larg, const char* s, uint8_t n) {
+    if (n > larg) { memset(l + col, '*', larg); return; }
+    memset(l + col, ' ', larg - n);
+    memcpy(l + col + larg - n, s, n);
+}
+
+void lcdCampoInt(char* l, uint8_t col, uint8_t larg, long v) {
+    char tmp[12];
+    int  i = lcdDigitos(tmp, v);
+    lcdCampoDireita(l, col, larg, tmp + i, sizeof(tmp) - i);
+}
+
+/** Uma casa decimal (mesmo arredondamento de jsonDecimal1); NaN vira "-" */
+void lcdCampoDec1(char* l, uint8_t col, uint8_t larg, float v) {
+    if (isnan(v) || isinf(v)) { lcdCampoDireita(l, col, larg, "-", 1); return; }
+    long d = lround(v * 10.0);
+    unsigned long u = (d < 0) ? 0UL - (unsigned long)d : (unsigned long)d;
+    char tmp[12];
+    int  i = sizeof(tmp);
+    tmp[--i] = '0' + (u % 10);
+    tmp[--i] = '.';
+    u /= 10;
+    do { tmp[--i] = '0' + (u % 10); u /= 10; } while (u);
+    if (d < 0) tmp[--i] = '-';
+    lcdCampoDireita(l, col, larg, tmp + i, sizeof(tmp) - i);
+}
+
+/** Texto alinhado à esquerda em [col, col+larg), cortado se preciso */
+void lcdCampoTexto(char* l, uint8_t col, uint8_t larg, const char* s) {
+    size_t n = strnlen(s, larg);
+    memcpy(l + col, s, n);
+    memset(l + col + n, ' ', larg - n);
+}
+
+/** Número alinhado à esquerda a partir de col; devolve a coluna seguinte */
+uint8_t lcdNumero(char* l, uint8_t col, long v) {
+    char tmp[12];
+    int  i = lcdDigitos(tmp, v);
+    int  n = min((int)sizeof(tmp) - i, LCD_COLUNAS - col);
+    memcpy(l + col, tmp + i, n);
+    return col + n;
+}
+
+/** Duração como "hh:mm" em [col, col+5); a partir de 100 h, '*' */
+void lcdCampoHoras(char* l, uint8_t col, uint32_t seg) {
+    uint32_t m = seg / 60;
+    if (m / 60 > 99) { memset(l + col, '*', 5); return; }
+    lcdCampoInt(l, col, 2, m / 60);
+    l[col + 2] = ':';
+    l[col + 3] = '0' + (m % 60) / 10;
+    l[col + 4] = '0' + (m % 60) % 10;
+}
+
+/** Inteiro arredondado alinhado à direita; NaN vira "-" */
+void lcdCampoArred(char* l, uint8_t col, uint8_t larg, float v) {
+    if (isnan(v)) lcdCampoDireita(l, col, larg, "-", 1);
+    else          lcdCampoInt(l, col, larg, lroundf(v));
+}
+
+/** IPv4 a partir de col ("192.168.4.1") */
+void lcdCampoIp(char* l, uint8_t col, const IPAddress& ip) {
+    for (int k = 0; k < 4 && col < LCD_COLUNAS; k++) {
+        if (k) l[col++] = '.';
+        col = lcdNumero(l, col, ip[k]);
+    }
+}
+
+void lcdLimpar() {
+    halLcdLimpar();
+    memset(lcdQuadro, ' ', sizeof(lcdQuadro));
+    memset(lcdVidro,  ' ', sizeof(lcdVidro));
+    lcdCurCol = lcdCurLin = 0;   // clear volta o cursor para o início
+}
+
+bool lcdSuja(uint8_t l, uint8_t c) { return lcdQuadro[l][c] != lcdVidro[l][c]; }
+
+/** Envia ao display só as diferenças entre quadro e vidro */
+void lcdAtualizar() {
+    lcdFlushes++;
+    for (uint8_t l = 0; l < LCD_LINHAS; l++) {
+        uint8_t c = 0;
+        while (c < LCD_COLUNAS) {
+            if (!lcdSuja(l, c)) { c++; continue; }
+            uint8_t fim = c + 1;
+            while (fim < LCD_COLUNAS &&
+                   (lcdSuja(l, fim) || (fim + 1 < LCD_COLUNAS && lcdSuja(l, fim + 1)))) fim++;
+
+            if (lcdCurLin != l || lcdCurCol != c) { halLcdCursor(c, l);  lcdCursores++; }
+            halLcdEscrever(&lcdQuadro[l][c], fim - c);
+            memcpy(&lcdVidro[l][c], &lcdQuadro[l][c], fim - c);
+            lcdCelulas += fim - c;
+            lcdCurLin = l;
+            lcdCurCol = fim;   // depois da coluna 15 o endereço sai da área visível
+            c = fim;
+        }
+    }
+    halLcdEnviar();   // o lote inteiro numa transação (ou poucas, se passar de LCD_LOTE)
+}
+
+// ══════════════════════════════════════════════════════════
+//  LCD – telas com rotação automática
+//  Cada tela é um par de funções na tabela TELAS[]: desenhar()
+//  preenche o quadro e assinatura() resume só o que ela mostra
+//  (já arredondado como no display). A tarefa do display só
+//  redesenha quando a tela girou ou a assinatura mudou – para
+//  incluir uma tela nova basta uma linha na tabela.
+// ══════════════════════════════════════════════════════════
+//  Modelos das telas           0123456789012345
+const char MOD_DADOS_0[]    = "T:     C U:   %";
+const char MOD_DADOS_1[]    = "Luz:   %      lx";
+const char MOD_STATUS_0[]   = "Lampada:";
+const char MOD_STATUS_1[]   = "Motor:";
+const char MOD_REDE_0[]     = "AP:";
+const char MOD_REDE_1[]     = "Modo:";
+const char MOD_SAUDE_0[]    = "DHT:     F:";
+const char MOD_SAUDE_1[]    = "LDR:     DHT:  s";
+const char MOD_HOJE_0[]     = "T:     /     C";
+const char MOD_HOJE_1[]     = "U:   /   % hoje";
+const char MOD_RELES_0[]    = "Lamp. hoje:";
+const char MOD_RELES_1[]    = "Motor hoje:";
+const char MOD_CLIENTES_0[] = "Estacoes WiFi:";
+const char MOD_CLIENTES_1[] = "Paineis SSE:  /";
+static_assert(sizeof(MOD_DADOS_1) - 1 <= LCD_COLUNAS && sizeof(MOD_SAUDE_1) - 1 <= LCD_COLUNAS &&
+              sizeof(MOD_HOJE_1)  - 1 <= LCD_COLUNAS && sizeof(MOD_CLIENTES_1) - 1 <= LCD_COLUNAS,
+              "modelo de tela maior que o LCD");
+
+// ── assinatura das entradas de uma tela (FNV-1a sobre inteiros) ──
+#define ASSINATURA_INICIO  2166136261u
+
+uint32_t assinar(uint32_t h, int32_t v) {
+    for (int i = 0; i < 4; i++) { h ^= (uint8_t)(v >> (8 * i)); h *= 16777619u; }
+    return h;
+}
+
+/** Valor como o display mostra (décimos ou inteiro); NaN vira um valor fora da faixa */
+int32_t arredondado(float v, double escala) { return isnan(v) ? INT32_MIN : lround(v * escala); }   // como lcdCampoDec1
+
+void mostrarDados(const EstadoEstufa& e) {
+    char* l = lcdLinha(0, MOD_DADOS_0);
+    lcdCampoDec1 (l, 2, 5, e.temperatura);
+    lcdCampoArred(l, 11, 3, e.umidade);
+    l = lcdLinha(1, MOD_DADOS_1);
+    lcdCampoInt  (l, 4, 3, e.pctLuz);
+    lcdCampoInt  (l, 9, 5, e.lux);
+}
+
+uint32_t assinaturaDados(const EstadoEstufa& e) {
+    uint32_t h = assinar(ASSINATURA_INICIO, arredondado(e.temperatura, 10));
+    h = assinar(h, arredondado(e.umidade, 1));
+    h = assinar(h, e.pctLuz);
+    return assinar(h, e.lux);
+}
+
+void mostrarStatus(const EstadoEstufa& e) {
+    lcdCampoTexto(lcdLinha(0, MOD_STATUS_0), 9, 7, e.lampada ? "LIGADA" : "DESLIG.");
+    lcdCampoTexto(lcdLinha(1, MOD_STATUS_1), 9, 7, e.motor   ? "LIGADO" : "DESLIG.");
+}
+
+uint32_t assinaturaStatus(const EstadoEstufa& e) {
+    return assinar(ASSINATURA_INICIO, e.lampada | e.motor << 1);
+}
+
+void mostrarRede(const EstadoEstufa& e) {
+    lcdCampoIp   (lcdLinha(0, MOD_REDE_0), 4, WiFi.softAPIP());   // fixo depois do setup
+    lcdCampoTexto(lcdLinha(1, MOD_REDE_1), 6, 6, e.modoManual ? "MANUAL" : "AUTO");
+}
+
+uint32_t assinaturaRede(const EstadoEstufa& e) {
+    return assinar(ASSINATURA_INICIO, e.modoManual);
+}
+
+void mostrarSaude(const EstadoEstufa& e) {
+    char* l = lcdLinha(0, MOD_SAUDE_0);
+    lcdCampoTexto(l, 4, 4, NOMES_SAUDE_LCD[e.saudeDht]);
+    lcdCampoInt  (l, 11, 5, e.dhtFalhasSeguidas);
+    l = lcdLinha(1, MOD_SAUDE_1);
+    lcdCampoTexto(l, 4, 4, NOMES_SAUDE_LCD[e.saudeLdr]);
+    lcdCampoInt  (l, 13, 2, (long)min(halSegundos() - e.dhtUltimoBom, 100u));   // idade da leitura do DHT22; 100+ vira "**"
+}
+
+uint32_t assinaturaSaude(const EstadoEstufa& e) {
+    uint32_t h = assinar(ASSINATURA_INICIO, e.saudeDht | e.saudeLdr << 8);
+    h = assinar(h, e.dhtFalhasSeguidas);
+    return assinar(h, min(halSegundos() - e.dhtUltimoBom, 100u));   // a idade anda sem nova publicação
+}
+
+void mostrarHoje(const EstadoEstufa& e) {
+    char* l = lcdLinha(0, MOD_HOJE_0);
+    lcdCampoDec1(l, 2, 5, e.tempMinDia);
+    lcdCampoDec1(l, 8, 5, e.tempMaxDia);
+    l = lcdLinha(1, MOD_HOJE_1);
+    lcdCampoArred(l, 2, 3, e.umidMinDia);
+    lcdCampoArred(l, 6, 3, e.umidMaxDia);
+}
+
+uint32_t assinaturaHoje(const EstadoEstufa& e) {
+    uint32_t h = assinar(ASSINATURA_INICIO, arredondado(e.tempMinDia, 10));
+    h = assinar(h, arredondado(e.tempMaxDia, 10));
+    h = assinar(h, arredondado(e.umidMinDia, 1));
+    return assinar(h, arredondado(e.umidMaxDia, 1));
+}
+
+void mostrarTempoReles(const EstadoEstufa& e) {
+    lcdCampoHoras(lcdLinha(0, MOD_RELES_0), 11, e.lampSegDia);
+    lcdCampoHoras(lcdLinha(1, MOD_RELES_1), 11, e.motSegDia);
+}
+
+uint32_t assinaturaTempoReles(const EstadoEstufa& e) {
+    return assinar(assinar(ASSINATURA_INICIO, e.lampSegDia / 60), e.motSegDia / 60);
+}
+
+void mostrarClientes(const EstadoEstufa&) {
+    lcdCampoInt(lcdLinha(0, MOD_CLIENTES_0), 14, 2, WiFi.softAPgetStationNum());
+    char* l = lcdLinha(1, MOD_CLIENTES_1);
+    lcdCampoInt(l, 12, 2, sseConectados);
+    lcdCampoInt(l, 15, 1, SSE_MAX_CLIENTES);
+}
+
+uint32_t assinaturaClientes(const EstadoEstufa&) {
+    return assinar(ASSINATURA_INICIO, WiFi.softAPgetStationNum() | sseConectados << 8);
+}
+
+struct Tela {
+    void     (*desenhar)(const EstadoEstufa&);
+    uint32_t (*assinatura)(const EstadoEstufa&);   // muda quando o que a tela mostra muda
+};
+
+const Tela TELAS[] = {
+    { mostrarDados,      assinaturaDados      },
+    { mostrarStatus,     assinaturaStatus     },
+    { mostrarRede,       assinaturaRede       },
+    { mostrarSaude,      assinaturaSaude      },
+    { mostrarHoje,       assinaturaHoje       },
+    { mostrarTempoReles, assinaturaTempoReles },
+    { mostrarClientes,   assinaturaClientes   },
+};
+#define NUM_TELAS  (sizeof(TELAS) / sizeof(TELAS[0]))
+
+/** Linha de debug no Monitor Serie */
+void logSerial(const EstadoEstufa& e) {
+    Serial.print("T:");    Serial.print(e.temperatura, 1);
+    Serial.print(" U:");   Serial.print(e.umidade, 0);
+    Serial.print(" Luz:");  Serial.print((int)e.pctLuz);
+    Serial.print(" Lamp:"); Serial.print(e.lampada ? "ON" : "OFF");
+    Serial.print(" Mot:");  Serial.print(e.motor   ? "ON" : "OFF");
+    Serial.print(" Modo:"); Serial.print(e.modoManual ? "MAN" : "AUTO");
+    Serial.print(" LatP50:"); Serial.print(latenciaPercentil(latenciaFaixas, 50));
+    Serial.print(" P99:");    Serial.print(latenciaPercentil(latenciaFaixas, 99));
+    Serial.print(" Max:");    Serial.print(latenciaMaxUs); Serial.print("us");
+    Serial.print(" Perdidas:"); Serial.print(amostrasPerdidas);
+    Serial.print(" LogDesc:"); Serial.print(logDescartados);
+    Serial.print(" SsePul:"); Serial.println(sseFramesPulados);
+}
+
+/** Evento da agenda (a cada TEMPO_TELA): próxima tela */
+void eventoGirarTela() {
+    tela = (tela + 1) % NUM_TELAS;
+    xTaskNotifyGive(displayTarefa);
+}
+
+/** Evento da agenda (a cada TEMPO_LEITURA): linha de debug */
+void eventoLogSerial() {
+    EstadoEstufa e;
+    lerEstado(e);
+    logSerial(e);
+}
+
+/**
+ * Acorda quando o estado publicado muda, quando a tela gira ou a cada
+ * TEMPO_LEITURA (idade do DHT e clientes não passam pelo estado), mas
+ * só desenha e fala com o LCD se a tela atual ficou suja.
+ */
+// O que está no vidro: tela e assinatura do último desenho
+struct TelaDesenhada { int tela; uint32_t assinatura; };
+
+/** Uma passada da tarefa do display; true se redesenhou */
+bool displayPassada(TelaDesenhada& d, const EstadoEstufa& e, int t) {
+    const Tela& tl = TELAS[t];
+    uint32_t    a  = tl.assinatura(e);
+    if (t == d.tela && a == d.assinatura) return false;   // nem acorda o LCD
+    tl.desenhar(e);
+    lcdAtualizar();
+    d = { t, a };
+    return true;
+}
+
+void tarefaDisplay(void*) {
+    TelaDesenhada d = { -1, 0 };
+    for (;;) {
+        EstadoEstufa e;
+        lerEstado(e);
+        displayPassada(d, e, tela);
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TEMPO_LEITURA));
+    }
 }
 
 // ══════════════════════════════════════════════════════════
-//  LCD – três telas com rotação automática
+//  WEB SERVER – respostas longas sem bloquear
+//  O WebServer do core escreve com write() bloqueante: um leitor
+//  lento seguraria a tarefa web inteira (todos os pedidos e o SSE).
+//  /, /api/history e /api/log saem como o SSE: o handler monta o
+//  cabeçalho HTTP em pend de um slot e guarda uma cópia do cliente;
+//  a cada volta a tarefa web empurra pend com send(MSG_DONTWAIT) e,
+//  vazio, pede o próximo pedaço a produzir(). Um download só ocupa
+//  RESP_PEND_TAM de RAM e nunca espera a janela TCP.
 // ══════════════════════════════════════════════════════════
-void mostrarDados() {
-    lcd.setCursor(0,0);
-    lcd.print(pad16("T:" + String(temperatura,1) + "C  U:" + String((int)umidade) + "%"));
-    lcd.setCursor(0,1);
-    lcd.print(pad16("Luz: " + String(pctLuz) + "%"));
+/**
+ * Empurra pend[pos, tam) sem esperar a janela TCP. false = cliente
+ * caiu, deu erro ou ficou SSE_TRAVADO_MS sem aceitar nada.
+ */
+bool escoarPendente(WiFiClient& c, const char* pend, uint16_t& pos, uint16_t tam, unsigned long& cheioDesde) {
+    while (pos < tam) {
+        int r = send(c.fd(), pend + pos, tam - pos, MSG_DONTWAIT);
+        if (r > 0) { pos += r;  cheioDesde = 0;  continue; }
+        if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!cheioDesde) cheioDesde = millis() | 1;              // 0 = escoando
+            return (long)(millis() - cheioDesde) < SSE_TRAVADO_MS;   // o |1 pode estar 1 ms à frente
+        }
+        return false;
+    }
+    return true;
+}
+
+// Estado de /api/history entre pedaços. Retoma pelo tempo (proximo), não
+// pelo índice no anel: o índice anda quando um bloco antigo é descartado.
+struct GeradorHist {
+    uint32_t            de, ate, passo;
+    uint32_t            proximo;     // 1º segundo ainda não somado
+    const CamadaResumo* camada;      // nullptr = amostras de 1 s
+    AcumHist            balde;       // balde em andamento
+    bool                primeiro;
+};
+
+struct ClienteResposta {
+    WiFiClient    c;
+    char          pend[RESP_PEND_TAM];
+    uint16_t      pendTam, pendPos;
+    unsigned long cheioDesde;                     // millis() do primeiro EAGAIN; 0 = escoando
+    bool        (*produzir)(ClienteResposta& r);  // enche pend; nullptr = pend tem o fim; false = abortar
+    uint32_t      pos, seq;                       // página: byte | log: segmento e byte nele
+    GeradorHist   hist;
+};
+ClienteResposta respClientes[RESP_MAX_CLIENTES];
+volatile uint8_t respAtivas = 0;                  // recontado pela tarefa web
+
+void respLiberar(ClienteResposta& r) {
+    r.c.stop();
+    r.pendTam = r.pendPos = 0;
+    r.cheioDesde = 0;
+    r.produzir   = nullptr;
 }
 
-void mostrarStatus() {
-    lcd.setCursor(0,0);
-    lcd.print(pad16("Lampada: " + String(lampada ? "LIGADA " : "DESLIG.")));
-    lcd.setCursor(0,1);
-    lcd.print(pad16("Motor:   " + String(motor   ? "LIGADO " : "DESLIG.")));
+void respContar() {
+    uint8_t n = 0;
+    for (int i = 0; i < RESP_MAX_CLIENTES; i++) n += respClientes[i].c ? 1 : 0;
+    respAtivas = n;
+}
+
+/**
+ * Slot livre com o cabeçalho HTTP já em pend; nullptr (e 503 já
+ * respondido) se todos estão ocupados. O handler completa e chama
+ * respAceitar().
+ */
+ClienteResposta* respAbrir(const char* cabecalho) {
+    for (int i = 0; i < RESP_MAX_CLIENTES; i++) {
+        ClienteResposta& r = respClientes[i];
+        if (r.c.connected()) continue;
+        respLiberar(r);
+        size_t n = strlen(cabecalho);
+        memcpy(r.pend, cabecalho, n);
+        r.pendTam = n;
+        return &r;
+    }
+    server.send(503,"text/plain","limite de downloads simultaneos");
+    return nullptr;
 }
 
-void mostrarRede() {
-    IPAddress ip = WiFi.softAPIP();
-    String modo = modoManual ? "MANUAL" : "AUTO";
-    lcd.setCursor(0,0); lcd.print(pad16("AP: " + ip.toString()));
-    lcd.setCursor(0,1); lcd.print(pad16("Modo: " + modo));
+/** Guarda o cliente (a cópia mantém o socket vivo após o handler) e manda o que couber já */
+void respAceitar(ClienteResposta& r, bool (*produzir)(ClienteResposta&)) {
+    r.produzir = produzir;
+    r.c = server.client();
+    r.c.setNoDelay(true);
+    if (!escoarPendente(r.c, r.pend, r.pendPos, r.pendTam, r.cheioDesde)) respLiberar(r);
+    respContar();
+}
+
+// Transfer-Encoding: chunked – "xxxx\r\n" + dados + "\r\n"; o último leva "0\r\n\r\n"
+#define RESP_PEDACO_CAB 6
+#define RESP_PEDACO_FIM (2 + 5)
+
+/** Onde escrever os dados do próximo pedaço (depois do que já está em pend) e quanto cabe */
+char* respPedaco(ClienteResposta& r, size_t& cap) {
+    cap = RESP_PEND_TAM - r.pendTam - RESP_PEDACO_CAB - RESP_PEDACO_FIM;
+    return r.pend + r.pendTam + RESP_PEDACO_CAB;
+}
+
+/** Fecha o pedaço de n bytes; ultimo = acrescenta o pedaço vazio que encerra a resposta */
+void respPedacoFechar(ClienteResposta& r, size_t n, bool ultimo) {
+    static const char HEX[] = "0123456789abcdef";
+    char* p = r.pend + r.pendTam;
+    if (n) {   // tamanho com 4 dígitos fixos: zeros à esquerda valem no chunked
+        for (int k = 0; k < 4; k++) p[k] = HEX[(n >> (12 - 4 * k)) & 0xF];
+        memcpy(p + 4, "\r\n", 2);
+        memcpy(p + RESP_PEDACO_CAB + n, "\r\n", 2);
+        r.pendTam += RESP_PEDACO_CAB + n + 2;
+    }
+    if (ultimo) {
+        memcpy(r.pend + r.pendTam, "0\r\n\r\n", 5);
+        r.pendTam += 5;
+        r.produzir = nullptr;
+    }
 }
 
-void mostrarTela() {
-    switch(tela) {
-        case 0: mostrarDados();   break;
-        case 1: mostrarStatus();  break;
-        case 2: mostrarRede();    break;
+/** A cada volta da tarefa web: escoa, produz o próximo pedaço e fecha quem terminou ou travou */
+void respServir() {
+    for (int i = 0; i < RESP_MAX_CLIENTES; i++) {
+        ClienteResposta& r = respClientes[i];
+        if (!r.c) continue;
+        bool ok = true;
+        for (int k = 0; ok && k < RESP_PEDACOS_VOLTA; k++) {
+            ok = escoarPendente(r.c, r.pend, r.pendPos, r.pendTam, r.cheioDesde);
+            if (!ok || r.pendPos < r.pendTam) break;   // janela cheia: continua na próxima volta
+            if (!r.produzir) { respLiberar(r);  break; }   // terminou: Connection: close
+            r.pendTam = r.pendPos = 0;
+            ok = r.produzir(r);
+        }
+        if (!ok) {
+            if (r.cheioDesde) Serial.println("[WEB] download travado, desconectado (slot " + String(i) + ")");
+            respLiberar(r);
+        }
     }
+    respContar();
 }
 
 // ══════════════════════════════════════════════════════════
 //  WEB SERVER – página HTML (dashboard completo)
+//  Fonte em web/index.html; pagina_gz.h é gerado por
+//  tools/gerar_pagina.py (gzip + ETag) – rode após editar o HTML.
 // ══════════════════════════════════════════════════════════
+/** Próximo pedaço dos bytes gzip gravados na flash (Content-Length, sem chunked) */
+bool paginaProduzir(ClienteResposta& r) {
+    uint16_t n = min((uint32_t)RESP_PEND_TAM, (uint32_t)PAGINA_GZ_TAM - r.pos);
+    memcpy_P(r.pend, PAGINA_GZ + r.pos, n);
+    r.pendTam = n;
+    r.pos    += n;
+    if (r.pos >= PAGINA_GZ_TAM) r.produzir = nullptr;
+    return true;
+}
+
 void handleRoot() {
-/* ─── HTML inicia aqui ─── */
-static const char page[] =
-R"ENDOFHTML(<!DOCTYPE html>
-<html lang="pt-BR">
-<head>
-<meta charset="UTF-8">
-<meta name="viewport" content="width=device-width,initial-scale=1">
-<title>Dashboard Estufa</title>
-<style>
-  @import url('https://fonts.googleapis.com/css2?family=DM+Sans:wght@400;500;600&family=Orbitron:wght@600&display=swap');
-  :root{
-    --bg:#0d1117;--surface:#161b22;--border:#21262d;
-    --green:#39d353;--green-dim:#1e7a2e;
-    --amber:#e3a019;--amber-dim:#7a5510;
-    --red:#f85149;--red-dim:#7a2010;
-    --text:#c9d1d9;--text-dim:#8b949e;--text-bright:#f0f6fc;
-    --radius:10px;
-  }
-  *{box-sizing:border-box;margin:0;padding:0}
-  body{font-family:'DM Sans',sans-serif;background:var(--bg);color:var(--text);min-height:100vh;padding:20px 16px}
-
-  .hdr{text-align:center;margin-bottom:22px}
-  .hdr h1{font-family:'Orbitron',sans-serif;font-size:1.25rem;color:var(--text-bright);letter-spacing:2px;margin-bottom:6px}
-  .hdr .meta{font-size:.75rem;color:var(--text-dim)}
-  .hdr .meta .dot{display:inline-block;width:8px;height:8px;border-radius:50%;background:var(--green);margin-right:5px;animation:pulse 2s infinite}
-  @keyframes pulse{0%,100%{opacity:1}50%{opacity:.3}}
-
-  .mode-bar{display:flex;align-items:center;justify-content:center;gap:12px;margin-bottom:20px}
-  .mode-badge{font-size:.78rem;font-weight:600;padding:5px 14px;border-radius:20px;letter-spacing:1px}
-  .mode-badge.auto{background:var(--green-dim);color:var(--green)}
-  .mode-badge.manual{background:var(--amber-dim);color:var(--amber)}
-  .btn-mode{background:var(--surface);border:1px solid var(--border);color:var(--text);padding:5px 14px;border-radius:20px;font-size:.78rem;cursor:pointer;transition:.2s}
-  .btn-mode:hover{border-color:var(--amber);color:var(--amber)}
-
-  .cards{display:grid;grid-template-columns:repeat(3,1fr);gap:10px;max-width:680px;margin:0 auto 20px}
-  .card{background:var(--surface);border:1px solid var(--border);border-radius:var(--radius);padding:16px 10px;text-align:center;position:relative;overflow:hidden;transition:border-color .3s}
-  .card::before{content:'';position:absolute;inset:0;opacity:.06;background:linear-gradient(135deg,var(--accent),transparent)}
-  .card[data-color=green]{--accent:var(--green);border-color:var(--green-dim)}
-  .card[data-color=amber]{--accent:var(--amber);border-color:var(--amber-dim)}
-  .card[data-color=red]  {--accent:var(--red);  border-color:var(--red-dim)}
-  .card .ico{font-size:1.5rem;position:relative}
-  .card .lbl{font-size:.68rem;text-transform:uppercase;letter-spacing:1.5px;color:var(--text-dim);margin:5px 0 3px;position:relative}
-  .card .val{font-size:1.6rem;font-weight:600;color:var(--text-bright);position:relative}
-  .card .unit{font-size:.68rem;color:var(--text-dim);position:relative}
-  .card .bar-bg{margin-top:10px;height:4px;background:var(--border);border-radius:2px;overflow:hidden;position:relative}
-  .card .bar-fill{height:100%;border-radius:2px;background:var(--green);width:0%;transition:width .6s ease,background .4s}
-  .card .bar-fill.amber{background:var(--amber)}
-  .card .bar-fill.red   {background:var(--red)}
-
-  .sec{max-width:680px;margin:0 auto 20px}
-  .sec-t{font-size:.68rem;text-transform:uppercase;letter-spacing:2px;color:var(--text-dim);border-bottom:1px solid var(--border);padding-bottom:6px;margin-bottom:10px}
-  .relay{display:flex;align-items:center;justify-content:space-between;background:var(--surface);border:1px solid var(--border);border-radius:var(--radius);padding:14px 16px;margin-bottom:8px;transition:border-color .3s}
-  .relay.on{border-color:var(--green-dim)}
-  .relay .rname{font-size:.88rem;font-weight:500}
-  .relay .ractions{display:flex;align-items:center;gap:10px}
-  .badge{font-size:.72rem;font-weight:600;padding:3px 10px;border-radius:12px;letter-spacing:.5px}
-  .badge.on {background:var(--green-dim);color:var(--green)}
-  .badge.off{background:var(--border);color:var(--text-dim)}
-  .btn-relay{background:var(--surface);border:1px solid var(--border);color:var(--text);padding:4px 12px;border-radius:6px;font-size:.76rem;cursor:pointer;transition:.2s;display:none}
-  .btn-relay:hover{opacity:.8}
-  .btn-relay.ligar   {border-color:var(--green);color:var(--green)}
-  .btn-relay.desligar{border-color:var(--red);  color:var(--red)}
-
-  .cfg-grid{display:grid;grid-template-columns:1fr 1fr;gap:8px}
-  .cfg-item{background:var(--surface);border:1px solid var(--border);border-radius:var(--radius);padding:10px}
-  .cfg-item label{font-size:.7rem;color:var(--text-dim);display:block;margin-bottom:4px}
-  .cfg-item input{width:100%;padding:5px 8px;border-radius:6px;border:1px solid var(--border);background:var(--bg);color:var(--text-bright);font-size:.85rem;outline:none;transition:border-color .2s}
-  .cfg-item input:focus{border-color:var(--amber)}
-  .cfg-group-lbl{grid-column:1/-1;font-size:.72rem;color:var(--amber);font-weight:600;margin-top:4px;padding-top:4px;border-top:1px solid var(--border)}
-  .btn-save{width:100%;margin-top:14px;padding:9px;background:var(--green-dim);border:1px solid var(--green);color:var(--green);border-radius:var(--radius);font-size:.82rem;font-weight:600;cursor:pointer;transition:.2s}
-  .btn-save:hover{background:var(--green);color:#0d1117}
-
-  .toast{position:fixed;bottom:24px;left:50%;transform:translateX(-50%) translateY(60px);background:var(--surface);border:1px solid var(--green);color:var(--green);padding:9px 22px;border-radius:20px;font-size:.8rem;font-weight:600;transition:transform .3s;z-index:99;pointer-events:none}
-  .toast.show{transform:translateX(-50%) translateY(0)}
-
-  @media(max-width:480px){
-    .cards{grid-template-columns:1fr 1fr}
-    .cfg-grid{grid-template-columns:1fr}
-  }
-</style>
-</head>
-<body>
-
-<div class="hdr">
-  <h1>🌿 ESTUFA</h1>
-  <div class="meta"><span class="dot"></span>Conectado &nbsp;|&nbsp; IP: <span id="ipAddr">–</span> &nbsp;|&nbsp; <span id="upd">–</span></div>
-</div>
-
-<div class="mode-bar">
-  <span class="mode-badge auto" id="modeBadge">AUTO</span>
-  <button class="btn-mode" id="modeBtn" onclick="toggleMode()">Ativar Manual</button>
-</div>
-
-<div class="cards">
-  <div class="card" id="cardTemp" data-color="green">
-    <div class="ico">🌡️</div>
-    <div class="lbl">Temperatura</div>
-    <div class="val" id="vTemp">–</div>
-    <div class="unit">°C</div>
-    <div class="bar-bg"><div class="bar-fill" id="barTemp"></div></div>
-  </div>
-  <div class="card" id="cardUmid" data-color="green">
-    <div class="ico">💧</div>
-    <div class="lbl">Umidade</div>
-    <div class="val" id="vUmid">–</div>
-    <div class="unit">%</div>
-    <div class="bar-bg"><div class="bar-fill" id="barUmid"></div></div>
-  </div>
-  <div class="card" id="cardLuz" data-color="green">
-    <div class="ico">☀️</div>
-    <div class="lbl">Luminosidade</div>
-    <div class="val" id="vLuz">–</div>
-    <div class="unit">%</div>
-    <div class="bar-bg"><div class="bar-fill" id="barLuz"></div></div>
-  </div>
-</div>
-
-<div class="sec">
-  <div class="sec-t">Relés</div>
-  <div class="relay" id="rowLamp">
-    <span class="rname">💡 Lâmpada Grow</span>
-    <div class="ractions">
-      <span class="badge off" id="bLamp">DESLIG.</span>
-      <button class="btn-relay" id="btnLamp"></button>
-    </div>
-  </div>
-  <div class="relay" id="rowMot">
-    <span class="rname">🌀 Motor / Ventilador</span>
-    <div class="ractions">
-      <span class="badge off" id="bMot">DESLIG.</span>
-      <button class="btn-relay" id="btnMot"></button>
-    </div>
-  </div>
-</div>
-
-<div class="sec">
-  <div class="sec-t">⚙️ Limiares – modo automático</div>
-  <div class="cfg-grid">
-    <div class="cfg-group-lbl">🌀 Motor / Ventilador</div>
-    <div class="cfg-item"><label>Temperatura ligar (°C)</label><input type="number" id="cTL" step="0.5"></div>
-    <div class="cfg-item"><label>Temperatura desligar (°C)</label><input type="number" id="cTD" step="0.5"></div>
-    <div class="cfg-item"><label>Umidade ligar (%)</label><input type="number" id="cUL" step="1"></div>
-    <div class="cfg-item"><label>Umidade desligar (%)</label><input type="number" id="cUD" step="1"></div>
-    <div class="cfg-group-lbl">💡 Lâmpada Grow</div>
-    <div class="cfg-item"><label>Luminosidade ligar (%)</label><input type="number" id="cLL" step="1"></div>
-    <div class="cfg-item"><label>Luminosidade desligar (%)</label><input type="number" id="cLD" step="1"></div>
-  </div>
-  <button class="btn-save" onclick="saveConfig()">💾 Salvar configurações</button>
-</div>
-
-<div class="toast" id="toast">Salvo</div>
-
-<script>
-let isManual=false;
-
-async function poll(){
-  try{
-    const r=await fetch('/api/data');
-    const d=await r.json();
-    document.getElementById('vTemp').textContent=d.temp;
-    document.getElementById('vUmid').textContent=d.umid;
-    document.getElementById('vLuz').textContent=d.luz;
-    updateBar('barTemp','cardTemp',d.temp,27,30);
-    updateBar('barUmid','cardUmid',d.umid,60,70);
-    updateBar('barLuz','cardLuz',d.luz,35,75);
-    updRelay('rowLamp','bLamp','btnLamp',d.lampada,'lamp');
-    updRelay('rowMot','bMot','btnMot',d.motor,'motor');
-    isManual=d.modoManual===1;
-    updateModeUI();
-    setIfBlur('cTL',d.tempLigar);
-    setIfBlur('cTD',d.tempDeslig);
-    setIfBlur('cUL',d.umidLigar);
-    setIfBlur('cUD',d.umidDeslig);
-    setIfBlur('cLL',d.luzLigar);
-    setIfBlur('cLD',d.luzDeslig);
-    document.getElementById('upd').textContent=new Date().toLocaleTimeString();
-  }catch(e){}
-}
-setInterval(poll,1200);
-
-function setIfBlur(id,v){
-  const el=document.getElementById(id);
-  if(document.activeElement!==el) el.value=v;
-}
-
-function updateBar(barId,cardId,val,warn,danger){
-  document.getElementById(barId).style.width=Math.min(val,100)+'%';
-  document.getElementById(barId).className='bar-fill'+(val>=danger?' red':val>=warn?' amber':'');
-  document.getElementById(cardId).dataset.color=val>=danger?'red':val>=warn?'amber':'green';
-}
-
-function updRelay(rowId,badgeId,btnId,state,ch){
-  const on=state===1;
-  const row=document.getElementById(rowId);
-  const badge=document.getElementById(badgeId);
-  const btn=document.getElementById(btnId);
-  row.className='relay'+(on?' on':'');
-  badge.textContent=on?'LIGADO':'DESLIG.';
-  badge.className='badge '+(on?'on':'off');
-  if(isManual){
-    btn.style.display='inline-block';
-    btn.textContent=on?'Desligar':'Ligar';
-    btn.className='btn-relay '+(on?'desligar':'ligar');
-    btn.onclick=()=>setRelay(ch,on?0:1);
-  } else btn.style.display='none';
-}
-
-function updateModeUI(){
-  const b=document.getElementById('modeBadge');
-  const btn=document.getElementById('modeBtn');
-  if(isManual){b.textContent='MANUAL';b.className='mode-badge manual';btn.textContent='Ativar Auto';}
-  else        {b.textContent='AUTO';  b.className='mode-badge auto';  btn.textContent='Ativar Manual';}
-}
-
-async function toggleMode(){ await post('mode',{mode:isManual?0:1}); }
-async function setRelay(ch,st){ await post('relay',{channel:ch,state:st}); }
-
-async function saveConfig(){
-  const tl=+document.getElementById('cTL').value;
-  const td=+document.getElementById('cTD').value;
-  if(td>=tl){showToast('Temp desligar deve ser menor que ligar',true);return;}
-  const ul=+document.getElementById('cUL').value;
-  const ud=+document.getElementById('cUD').value;
-  if(ud>=ul){showToast('Umid desligar deve ser menor que ligar',true);return;}
-  const ll=+document.getElementById('cLL').value;
-  const ld=+document.getElementById('cLD').value;
-  if(ld<=ll){showToast('Luz desligar deve ser maior que ligar',true);return;}
-  await post('config',{tempLigar:tl,tempDeslig:td,umidLigar:ul,umidDeslig:ud,luzLigar:ll,luzDeslig:ld});
-  showToast('Configurações salvas ✓');
-}
-
-async function post(endpoint,data){
-  try{
-    const r=await fetch('/api/'+endpoint,{method:'POST',headers:{'Content-Type':'application/x-www-form-urlencoded'},body:new URLSearchParams(data).toString()});
-    return await r.json();
-  }catch(e){showToast('Erro de comunicação',true);}
-}
-
-function showToast(msg,isErr){
-  const t=document.getElementById('toast');
-  t.textContent=msg;
-  t.style.borderColor=isErr?'var(--red)':'var(--green)';
-  t.style.color=isErr?'var(--red)':'var(--green)';
-  t.classList.add('show');
-  setTimeout(()=>t.classList.remove('show'),2200);
-}
-
-document.getElementById('ipAddr').textContent=window.location.hostname;
-</script>
-</body>
-</html>
-)ENDOFHTML";
-/* ─── HTML termina aqui ─── */
-
-    server.sendHeader("Connection","close");
-    server.send(200, "text/html; charset=UTF-8", page);
+    if (server.header("If-None-Match") == PAGINA_ETAG) {
+        server.sendHeader("ETag", PAGINA_ETAG);
+        server.sendHeader("Cache-Control", "no-cache");   // sempre revalida; 304 sai quase de graça
+        server.send(304);
+        return;
+    }
+
+    static const char CABECALHO[] = "HTTP/1.1 200 OK\r\n"
+                                    "Content-Type: text/html; charset=UTF-8\r\n"
+                                    "Content-Encoding: gzip\r\n"
+                                    "Content-Length: %u\r\n"
+                                    "ETag: " PAGINA_ETAG "\r\n"
+                                    "Cache-Control: no-cache\r\n"
+                                    "Connection: close\r\n\r\n";
+    char cab[sizeof(CABECALHO) + 8];
+    snprintf(cab, sizeof(cab), CABECALHO, (unsigned)PAGINA_GZ_TAM);
+    ClienteResposta* r = respAbrir(cab);
+    if (!r) return;
+    r->pos = 0;
+    respAceitar(*r, paginaProduzir);
 }
 
 // ══════════════════════════════════════════════════════════
 //  WEB SERVER – API endpoints
 // ══════════════════════════════════════════════════════════
 
-/** GET /api/data – retorna JSON com leituras e configuração atual */
-void handleGetData() {
-    String j;
-    j.reserve(256);
-    j  = "{\"temp\":"    + String(temperatura, 1);
-    j += ",\"umid\":"    + String(umidade, 1);
-    j += ",\"luz\":"     + String(pctLuz);
-    j += ",\"lampada\":" + String(lampada ? 1 : 0);
-    j += ",\"motor\":"   + String(motor   ? 1 : 0);
-    j += ",\"modoManual\":" + String(modoManual ? 1 : 0);
-    j += ",\"tempLigar\":"  + String(cfg_tempLigar,  1);
-    j += ",\"tempDeslig\":" + String(cfg_tempDeslig, 1);
-    j += ",\"umidLigar\":"  + String(cfg_umidLigar,  1);
-    j += ",\"umidDeslig\":" + String(cfg_umidDeslig, 1);
-    j += ",\"luzLigar\":"   + String(cfg_luzLigar);
-    j += ",\"luzDeslig\":"  + String(cfg_luzDeslig);
-    j += "}";
+/**
+ * Serializa um snapshot do estado em buf; retorna o tamanho (sem '\0')
+ * ou 0 se não coube em cap – nunca devolve JSON cortado. Sem
+ * diagnostico (SSE) saem idade e contadores: o frame só muda quando o
+ * estado muda.
+ */
+size_t montarJsonEstado(char* buf, size_t cap, const EstadoEstufa& e, bool diagnostico = true) {
+    JsonBuf j;
+    jsonIniciar(j, buf, cap);
+    jsonTexto(j, "{\"temp\":");        jsonDecimal1(j, e.temperatura);
+    jsonTexto(j, ",\"umid\":");        jsonDecimal1(j, e.umidade);
+    jsonTexto(j, ",\"luz\":");         jsonInteiro(j, e.pctLuz);
+    jsonTexto(j, ",\"lux\":");         jsonInteiro(j, e.lux);
+    jsonTexto(j, ",\"lampada\":");     jsonInteiro(j, e.lampada ? 1 : 0);
+    jsonTexto(j, ",\"motor\":");       jsonInteiro(j, e.motor   ? 1 : 0);
+    jsonTexto(j, ",\"modoManual\":");  jsonInteiro(j, e.modoManual ? 1 : 0);
+    jsonTexto(j, ",\"tempLigar\":");   jsonDecimal1(j, e.cfg.tempLigar);
+    jsonTexto(j, ",\"tempDeslig\":");  jsonDecimal1(j, e.cfg.tempDeslig);
+    jsonTexto(j, ",\"umidLigar\":");   jsonDecimal1(j, e.cfg.umidLigar);
+    jsonTexto(j, ",\"umidDeslig\":");  jsonDecimal1(j, e.cfg.umidDeslig);
+    jsonTexto(j, ",\"luzLigar\":");    jsonInteiro(j, e.cfg.luzLigar);
+    jsonTexto(j, ",\"luzDeslig\":");   jsonInteiro(j, e.cfg.luzDeslig);
+    bool degradado = !e.modoManual && (saudeDegradada(e.saudeDht, e.dhtFalhasSeguidas) ||
+                                       saudeDegradada(e.saudeLdr, 0));   // o LDR nunca acumula saltos
+    jsonTexto(j, ",\"degradado\":");   jsonInteiro(j, degradado);
+    jsonTexto(j, ",\"ldr\":{\"saude\":\""); jsonTexto(j, NOMES_SAUDE[e.saudeLdr]); jsonTexto(j, "\"}");
+    jsonTexto(j, ",\"dht\":{\"saude\":\""); jsonTexto(j, NOMES_SAUDE[e.saudeDht]);
+    jsonTexto(j, "\",\"seguidas\":");   jsonInteiro(j, e.dhtFalhasSeguidas);
+    jsonTexto(j, ",\"status\":\"");     jsonTexto(j, NOMES_STATUS_DHT[e.dhtStatus]); jsonTexto(j, "\"");
+    if (diagnostico) {
+        jsonTexto(j, ",\"idade\":");     jsonInteiro(j, (long)(halSegundos() - e.dhtUltimoBom));
+        for (int s = 0; s < 4; s++) {   // transações por resultado
+            jsonTexto(j, ",\"");  jsonTexto(j, NOMES_STATUS_DHT[s]);  jsonTexto(j, "\":");
+            jsonInteiro(j, e.dhtContagem[s]);
+        }
+    }
+    jsonTexto(j, "}");
+    for (int c = 0; c < 2; c++) {   // proteção dos relés
+        jsonTexto(j, c ? ",\"motor\":{" : ",\"reles\":{\"lamp\":{");
+        jsonTexto(j, "\"pendente\":");     jsonInteiro(j, e.relePendente[c] ? 1 : 0);
+        jsonTexto(j, ",\"trocasHora\":");  jsonInteiro(j, e.releTrocasHora[c]);
+        if (diagnostico) { jsonTexto(j, ",\"suprimidos\":");  jsonInteiro(j, e.releSuprimidos[c]); }
+        jsonTexto(j, "}");
+    }
+    jsonTexto(j, "}}");
+    return j.estouro ? 0 : j.len;
+}
+
+/** Responde 200 com o JSON de buf, ou 500 se ele estourou o buffer (n == 0) */
+void enviarJson(const char* buf, size_t n) {
+    if (!n) {
+        Serial.println("[WEB] JSON truncado em " + server.uri() + " – aumente o buffer");
+        server.send(500,"text/plain","JSON truncado");
+        return;
+    }
     server.sendHeader("Cache-Control","no-store");
-    server.send(200, "application/json", j);
+    server.send_P(200, "application/json", buf, n);
+}
+
+/** GET /api/data – leituras, configuração e diagnóstico (idade do DHT22, contadores) */
+void handleGetData() {
+    char buf[JSON_TAM_ESTADO];
+    EstadoEstufa e;
+    lerEstado(e);
+    enviarJson(buf, montarJsonEstado(buf, sizeof(buf), e));
+}
+
+void sseLiberar(ClienteSse& s) {
+    s.c.stop();
+    s.pendTam = s.pendPos = 0;
+    s.atrasado = false;
+    s.cheioDesde = 0;
+}
+
+/** Coloca o último estado publicado (sseUltimo) como próximo frame do cliente */
+void sseEnfileirarUltimo(ClienteSse& s) {
+    memcpy(s.pend, "data: ", 6);
+    memcpy(s.pend + 6, sseUltimo, sseUltimoLen);
+    memcpy(s.pend + 6 + sseUltimoLen, "\n\n", 2);
+    s.pendTam  = sseUltimoLen + 8;
+    s.pendPos  = 0;
+    s.atrasado = false;
+}
+
+/** Empurra o pendente (escoarPendente); escoado, enfileira o frame que o cliente perdeu */
+bool sseEscoar(ClienteSse& s) {
+    if (!escoarPendente(s.c, s.pend, s.pendPos, s.pendTam, s.cheioDesde)) return false;
+    if (s.pendPos == s.pendTam && s.atrasado && sseUltimoLen) sseEnfileirarUltimo(s);   // sai na próxima volta
+    return true;
+}
+
+/** Recontagem para a tela de clientes (só esta tarefa mexe nos slots) */
+void sseContar() {
+    uint8_t n = 0;
+    for (int i = 0; i < SSE_MAX_CLIENTES; i++) n += sseClientes[i].c ? 1 : 0;
+    sseConectados = n;
+}
+
+/** A cada volta da tarefa web: escoa pendentes e derruba quem travou */
+void sseServir() {
+    for (int i = 0; i < SSE_MAX_CLIENTES; i++) {
+        ClienteSse& s = sseClientes[i];
+        if (!s.c) continue;
+        if (!s.c.connected() || !sseEscoar(s)) {
+            if (s.cheioDesde) Serial.println("[WEB] cliente SSE travado, desconectado (slot " + String(i) + ")");
+            sseLiberar(s);
+        }
+    }
+    sseContar();
+}
+
+/**
+ * Publica o estado para todos os clientes SSE – só quando o JSON mudou
+ * desde o último envio ou quando o keepalive venceu (forcar = true).
+ */
+void ssePublicar(bool forcar) {
+    char json[JSON_TAM_ESTADO];
+    EstadoEstufa e;
+    lerEstado(e);
+    size_t n = montarJsonEstado(json, sizeof(json), e, false);
+    if (!n) { Serial.println("[SSE] JSON truncado, frame descartado"); return; }
+
+    bool mudou = (n != sseUltimoLen) || memcmp(json, sseUltimo, n) != 0;
+    if (!mudou && !forcar) return;
+
+    memcpy(sseUltimo, json, n);
+    sseUltimoLen = n;
+    tSse = millis();
+
+    for (int i = 0; i < SSE_MAX_CLIENTES; i++) {
+        ClienteSse& s = sseClientes[i];
+        if (!s.c) continue;
+        if (s.pendPos < s.pendTam) { s.atrasado = true;  sseFramesPulados++; }
+        else                       sseEnfileirarUltimo(s);
+    }
+    sseServir();
+}
+
+/** GET /api/stream – mantém o socket aberto e empurra o estado via SSE */
+void handleStream() {
+    int livre = -1;
+    for (int i = 0; i < SSE_MAX_CLIENTES; i++) {
+        if (!sseClientes[i].c.connected()) { sseLiberar(sseClientes[i]); if (livre < 0) livre = i; }
+    }
+    if (livre < 0) { server.send(503,"text/plain","limite de clientes SSE"); return; }
+
+    // primeiro frame imediato, sem esperar mudança; cabeçalho vai junto no pendente
+    static const char CABECALHO[] = "HTTP/1.1 200 OK\r\n"
+                                    "Content-Type: text/event-stream\r\n"
+                                    "Cache-Control: no-store\r\n"
+                                    "Connection: keep-alive\r\n\r\n"
+                                    "retry: 3000\n\n";
+    static_assert(sizeof(CABECALHO) - 1 <= SSE_CABECALHO_TAM, "aumente SSE_CABECALHO_TAM");
+    ClienteSse& s = sseClientes[livre];
+    EstadoEstufa e;
+    lerEstado(e);
+    size_t h = sizeof(CABECALHO) - 1;
+    size_t n = montarJsonEstado(s.pend + h + 6, JSON_TAM_ESTADO, e, false);
+    if (!n) { enviarJson(nullptr, 0); return; }
+    memcpy(s.pend, CABECALHO, h);
+    memcpy(s.pend + h, "data: ", 6);
+    memcpy(s.pend + h + 6 + n, "\n\n", 2);
+    s.pendTam    = h + n + 8;
+    s.pendPos    = 0;
+    s.atrasado   = false;
+    s.cheioDesde = 0;
+
+    s.c = server.client();   // a cópia mantém o socket vivo após o handler
+    s.c.setNoDelay(true);
+    if (!sseEscoar(s)) { sseLiberar(s); return; }
+    sseContar();
+    Serial.println("[WEB] cliente SSE conectado (slot " + String(livre) + ")");
+}
+
+/**
+ * Escreve [t, tMin,tMed,tMax, uMin,uMed,uMax, lMin,lMed,lMax(, lampPct,motPct)].
+ * Depois de um estouro não escreve mais nada (historicoProduzir aborta a resposta).
+ */
+void baldeEmitir(JsonBuf& j, const AcumHist& b, bool& primeiro, bool comReles) {
+    if (!b.n || j.estouro) return;
+    jsonTexto(j, primeiro ? "[" : ",[");
+    primeiro = false;
+    jsonInteiro(j, b.inicio);
+    jsonTexto(j, ",");  jsonDecimos(j, b.tMin);
+    jsonTexto(j, ",");  jsonDecimos(j, mediaArred(b.tSoma, b.n));
+    jsonTexto(j, ",");  jsonDecimos(j, b.tMax);
+    jsonTexto(j, ",");  jsonDecimos(j, b.uMin);
+    jsonTexto(j, ",");  jsonDecimos(j, mediaArred(b.uSoma, b.n));
+    jsonTexto(j, ",");  jsonDecimos(j, b.uMax);
+    jsonTexto(j, ",");  jsonInteiro(j, b.lMin);
+    jsonTexto(j, ",");  jsonInteiro(j, mediaArred(b.lSoma, b.n));
+    jsonTexto(j, ",");  jsonInteiro(j, b.lMax);
+    if (comReles) {
+        jsonTexto(j, ",");  jsonInteiro(j, mediaArred(b.lampOn * 100, b.n));
+        jsonTexto(j, ",");  jsonInteiro(j, mediaArred(b.motOn  * 100, b.n));
+    }
+    jsonTexto(j, "]");
+}
+
+// folga no pedaço para mais um balde e o fecho "]}" (um balde tem < 96 bytes)
+#define HIST_FOLGA 192
+
+/** Primeiro bloco (índice lógico) que ainda tem amostras em t >= de */
+uint32_t historicoBuscar(uint32_t de) {
+    uint32_t lo = 0, hi = historicoBlocosVivos();
+    BlocoHist b;
+    while (lo < hi) {
+        uint32_t meio = (lo + hi) / 2;
+        if (!historicoCopiarBloco(meio, b)) { hi = meio; continue; }
+        if (b.t0 + b.n <= de) lo = meio + 1; else hi = meio;
+    }
+    return lo;
+}
+
+/**
+ * Baldes a partir das amostras de 1 s (decodifica os blocos do anel), do
+ * segundo g.proximo em diante. true = chegou em g.ate; false = o pedaço
+ * encheu ou já decodificou HIST_BLOCOS_PEDACO blocos.
+ */
+bool historicoBaldesBrutos(JsonBuf& j, GeradorHist& g) {
+    BlocoHist b;
+    uint32_t  blocos = 0;
+    for (uint32_t i = historicoBuscar(g.proximo); historicoCopiarBloco(i, b); i++) {
+        if (b.t0 >= g.ate) return true;
+        if (++blocos > HIST_BLOCOS_PEDACO) return false;
+
+        int16_t t = b.temp0, u = b.umid0;
+        int     l = b.luz0;
+        uint8_t pos = 0;
+        for (uint8_t k = 0; k < b.n; k++) {
+            if (k) {
+                t += histTirarDelta(b.dados, pos);
+                u += histTirarDelta(b.dados, pos);
+                l += histTirarDelta(b.dados, pos);
+            }
+            uint32_t ts = b.t0 + k;
+            if (ts < g.proximo) continue;   // já somado (ou antes de 'de')
+            if (ts >= g.ate)    return true;
+            uint32_t inicio = g.de + (ts - g.de) / g.passo * g.passo;
+            if (inicio != g.balde.inicio) {
+                if (j.len > j.cap - HIST_FOLGA) return false;   // retoma em ts no próximo pedaço
+                baldeEmitir(j, g.balde, g.primeiro, false);
+                acumZerar(g.balde, inicio);
+            }
+            acumSomar(g.balde, t, u, (uint8_t)l, false, false);
+            g.proximo = ts + 1;
+        }
+    }
+    return true;
+}
+
+/** Baldes a partir de uma camada de resumos (passo múltiplo do período); mesmo contrato */
+bool historicoBaldesResumo(JsonBuf& j, GeradorHist& g) {
+    const CamadaResumo& c = *g.camada;
+    Resumo r;
+    for (uint32_t i = camadaBuscar(c, g.proximo); camadaCopiar(c, i, r); i++) {
+        if (r.t0 >= g.ate) return true;
+        uint32_t ts     = r.t0 < g.de ? g.de : r.t0;
+        uint32_t inicio = g.de + (ts - g.de) / g.passo * g.passo;
+        if (inicio != g.balde.inicio) {
+            if (j.len > j.cap - HIST_FOLGA) return false;
+            baldeEmitir(j, g.balde, g.primeiro, true);
+            acumZerar(g.balde, inicio);
+        }
+        acumSomarResumo(g.balde, r);
+        g.proximo = r.t0 + c.periodo;
+    }
+    return true;
+}
+
+/** Próximo pedaço de /api/history; no fim, o último balde e o fecho do JSON */
+bool historicoProduzir(ClienteResposta& r) {
+    GeradorHist& g = r.hist;
+    size_t cap;
+    char*  p = respPedaco(r, cap);
+    JsonBuf j;
+    jsonIniciar(j, p, cap);
+    bool fim = g.camada ? historicoBaldesResumo(j, g) : historicoBaldesBrutos(j, g);
+    if (fim) {
+        baldeEmitir(j, g.balde, g.primeiro, g.camada);
+        jsonTexto(j, "]}");
+    }
+    if (j.estouro) {
+        // sem o pedaço final o cliente vê a resposta incompleta
+        Serial.println("[WEB] /api/history truncado, resposta abortada");
+        return false;
+    }
+    respPedacoFechar(r, j.len, fim);
+    return true;
+}
+
+/**
+ * GET /api/history?from=&to=&step= – série reduzida com min/méd/máx
+ * por balde. Tempos em segundos desde o boot ("agora" vem na resposta);
+ * padrão: última hora em baldes de 60 s. A fonte é a camada mais grossa
+ * que divide o passo (1 h, 1 min ou amostras de 1 s) – as camadas também
+ * trazem o duty cycle dos relés. A resposta sai em pedaços chunked,
+ * um por vez, pela tarefa web (historicoProduzir).
+ */
+void handleHistory() {
+    uint32_t agora = halSegundos();
+    uint32_t ate   = server.hasArg("to")   ? server.arg("to").toInt()   : agora + 1;
+    uint32_t de    = server.hasArg("from") ? server.arg("from").toInt() : (ate > 3600 ? ate - 3600 : 0);
+    uint32_t passo = server.hasArg("step") ? server.arg("step").toInt() : 60;
+    if (passo == 0 || ate <= de || (ate - de) / passo > HIST_MAX_BALDES) {
+        server.send(400,"text/plain","intervalo invalido (from < to, step > 0, no maximo 1440 pontos)");
+        return;
+    }
+    const CamadaResumo* camada = (passo % camadaHora.periodo == 0) ? &camadaHora
+                               : (passo % camadaMin.periodo  == 0) ? &camadaMin
+                               : nullptr;
+
+    ClienteResposta* r = respAbrir("HTTP/1.1 200 OK\r\n"
+                                   "Content-Type: application/json\r\n"
+                                   "Cache-Control: no-store\r\n"
+                                   "Transfer-Encoding: chunked\r\n"
+                                   "Connection: close\r\n\r\n");
+    if (!r) return;
+
+    size_t cap;
+    char*  p = respPedaco(*r, cap);
+    JsonBuf j;
+    jsonIniciar(j, p, cap);
+    jsonTexto(j, "{\"agora\":");  jsonInteiro(j, agora);
+    jsonTexto(j, ",\"from\":");   jsonInteiro(j, de);
+    jsonTexto(j, ",\"to\":");     jsonInteiro(j, ate);
+    jsonTexto(j, ",\"step\":");   jsonInteiro(j, passo);
+    jsonTexto(j, ",\"fonte\":");  jsonInteiro(j, camada ? camada->periodo : 1);
+    jsonTexto(j, ",\"campos\":[\"t\",\"tMin\",\"tMed\",\"tMax\",\"uMin\",\"uMed\",\"uMax\","
+                 "\"lMin\",\"lMed\",\"lMax\"");
+    if (camada) jsonTexto(j, ",\"lampPct\",\"motPct\"");
+    jsonTexto(j, "],\"dados\":[");
+    respPedacoFechar(*r, j.len, false);
+
+    GeradorHist& g = r->hist;
+    g.de = de;  g.ate = ate;  g.passo = passo;  g.proximo = de;
+    g.camada   = camada;
+    g.primeiro = true;
+    acumZerar(g.balde, de);
+    respAceitar(*r, historicoProduzir);
+}
+
+/**
+ * Próximo pedaço de /api/log: uma leitura da flash, só registros de CRC
+ * válido. O segmento é reaberto a cada pedaço – a rotação pode apagá-lo
+ * no meio do download. Para no 1º CRC errado de cada segmento (fim
+ * rasgado por queda de energia) e segue no próximo.
+ */
+bool logProduzir(ClienteResposta& r) {
+    size_t cap;
+    uint8_t* p = (uint8_t*)respPedaco(r, cap);
+    cap -= cap % sizeof(RegistroLog);
+    size_t n = 0, ok = 0;
+    char   nome[24];
+    logNomeSegmento(nome, sizeof(nome), r.seq);
+    File f = LittleFS.open(nome, "r");
+    if (f && f.seek(r.pos)) {
+        n  = f.read(p, cap);
+        ok = logPrefixoValido(p, n);
+    }
+    f.close();
+    r.pos += ok;
+    if (n < cap || ok < n) { r.seq++;  r.pos = 0; }   // segmento acabou, rasgou ou sumiu
+    respPedacoFechar(r, ok, r.seq > logSeqAtual);
+    return true;
+}
+
+/**
+ * GET /api/log – baixa o log binário (registros de 16 bytes, ver
+ * RegistroLog), do segmento mais antigo ao mais novo, só com registros
+ * de CRC válido. Sai em pedaços de até RESP_PEND_TAM pela tarefa web;
+ * o arquivo nunca vai inteiro para a RAM.
+ */
+void handleLog() {
+    if (!logAtivo) { server.send(503,"text/plain","log desativado"); return; }
+
+    ClienteResposta* r = respAbrir("HTTP/1.1 200 OK\r\n"
+                                   "Content-Type: application/octet-stream\r\n"
+                                   "Content-Disposition: attachment; filename=\"estufa_log.bin\"\r\n"
+                                   "Transfer-Encoding: chunked\r\n"
+                                   "Connection: close\r\n\r\n");
+    if (!r) return;
+    r->seq = logSeqPrimeiro;
+    r->pos = 0;
+    respAceitar(*r, logProduzir);
 }
 
 /** POST /api/mode – alterna modo automático / manual */
 void handleSetMode() {
     if (!server.hasArg("mode")) { server.send(400,"text/plain","falta 'mode'"); return; }
 
-    bool novoManual = (server.arg("mode").toInt() == 1);
-
-    if (novoManual && !modoManual) {
-        // entrando no modo manual: captura estados atuais dos relés
-        lampManual = lampada;
-        motManual  = motor;
-    }
-    modoManual = novoManual;
+    MsgControle m;
+    m.tipo   = MSG_MODO;
+    m.manual = (server.arg("mode").toInt() == 1);
+    if (!enviarControle(m)) { server.send(503,"text/plain","controle ocupado"); return; }
 
     server.send(200,"application/json","{\"ok\":1}");
-    Serial.println("[WEB] modo -> " + String(modoManual ? "MANUAL" : "AUTO"));
+    Serial.println("[WEB] modo -> " + String(m.manual ? "MANUAL" : "AUTO"));
 }
 
 /** POST /api/relay – liga/desliga um relé no modo manual */
@@ -558,42 +2693,123 @@ void handleSetRelay() {
     if (!server.hasArg("channel") || !server.hasArg("state")) {
         server.send(400,"text/plain","falta 'channel' ou 'state'"); return;
     }
-    if (!modoManual) {
-        server.send(403,"text/plain","modo automatico ativo"); return;
-    }
-
     String ch = server.arg("channel");
     int    st = server.arg("state").toInt();
 
-    if (ch == "lamp")  lampManual = (st == 1);
-    if (ch == "motor") motManual  = (st == 1);
+    EstadoEstufa e;
+    lerEstado(e);
+    if (!e.modoManual) {
+        server.send(403,"text/plain","modo automatico ativo"); return;
+    }
 
-    controlar();   // aplica imediatamente aos relés
+    MsgControle m;
+    m.tipo        = MSG_RELE;
+    m.rele.canal  = (ch == "lamp") ? 0 : (ch == "motor") ? 1 : 0xFF;
+    m.rele.ligado = (st == 1);
+    // controle tem prioridade máxima: o relé muda antes desta resposta sair,
+    // a menos que a proteção o segure (fica "pendente" em /api/data)
+    if (m.rele.canal != 0xFF && !enviarControle(m)) {
+        server.send(503,"text/plain","controle ocupado"); return;
+    }
     server.send(200,"application/json","{\"ok\":1}");
     Serial.println("[WEB] relay " + ch + " -> " + String(st));
 }
 
 /** POST /api/config – atualiza limiares de controle automático */
 void handleSetConfig() {
-    if (server.hasArg("tempLigar"))  cfg_tempLigar  = server.arg("tempLigar").toFloat();
-    if (server.hasArg("tempDeslig")) cfg_tempDeslig = server.arg("tempDeslig").toFloat();
-    if (server.hasArg("umidLigar"))  cfg_umidLigar  = server.arg("umidLigar").toFloat();
-    if (server.hasArg("umidDeslig")) cfg_umidDeslig = server.arg("umidDeslig").toFloat();
-    if (server.hasArg("luzLigar"))   cfg_luzLigar   = server.arg("luzLigar").toInt();
-    if (server.hasArg("luzDeslig"))  cfg_luzDeslig  = server.arg("luzDeslig").toInt();
+    MsgControle m;
+    m.tipo = MSG_CONFIG;
+    EstadoEstufa e;
+    lerEstado(e);
+    m.cfg = e.cfg;   // parte dos valores atuais; só os campos enviados são trocados
+    if (server.hasArg("tempLigar"))  m.cfg.tempLigar  = server.arg("tempLigar").toFloat();
+    if (server.hasArg("tempDeslig")) m.cfg.tempDeslig = server.arg("tempDeslig").toFloat();
+    if (server.hasArg("umidLigar"))  m.cfg.umidLigar  = server.arg("umidLigar").toFloat();
+    if (server.hasArg("umidDeslig")) m.cfg.umidDeslig = server.arg("umidDeslig").toFloat();
+    if (server.hasArg("luzLigar"))   m.cfg.luzLigar   = server.arg("luzLigar").toInt();
+    if (server.hasArg("luzDeslig"))  m.cfg.luzDeslig  = server.arg("luzDeslig").toInt();
+    // faixa do DHT22 e percentuais; também mantém o JSON do estado dentro de JSON_TAM_ESTADO
+    auto fora = [](float v, float lo, float hi) { return !(v >= lo && v <= hi); };   // NaN também
+    if (fora(m.cfg.tempLigar, -40, 80) || fora(m.cfg.tempDeslig, -40, 80) ||
+        fora(m.cfg.umidLigar, 0, 100)  || fora(m.cfg.umidDeslig, 0, 100)  ||
+        fora(m.cfg.luzLigar,  0, 100)  || fora(m.cfg.luzDeslig,  0, 100)) {
+        server.send(400,"text/plain","valor fora da faixa"); return;
+    }
+    // mesma regra do dashboard: histérese invertida ou de largura zero faz o relé oscilar
+    if (m.cfg.tempDeslig >= m.cfg.tempLigar) { server.send(400,"text/plain","tempDeslig deve ser menor que tempLigar"); return; }
+    if (m.cfg.umidDeslig >= m.cfg.umidLigar) { server.send(400,"text/plain","umidDeslig deve ser menor que umidLigar"); return; }
+    if (m.cfg.luzDeslig  <= m.cfg.luzLigar)  { server.send(400,"text/plain","luzDeslig deve ser maior que luzLigar");   return; }
+    if (!enviarControle(m)) { server.send(503,"text/plain","controle ocupado"); return; }
 
     server.send(200,"application/json","{\"ok\":1}");
     Serial.println("[WEB] config atualizada");
 }
 
+/**
+ * GET /api/energia – tempo ativo × ocioso por núcleo desde o boot e
+ * corrente estimada pelo modelo CORRENTE_*_MA.
+ */
+void handleEnergia() {
+    uint32_t totalMs = (uint32_t)((esp_timer_get_time() - energiaInicioUs) / 1000);
+    bool     semDfs  = strcmp(energiaModo, "desligado") == 0;
+    bool     fixo80  = strcmp(energiaModo, "fixo80") == 0;   // ativo também a ENERGIA_FREQ_MIN
+    char     buf[256];
+    JsonBuf  j;
+    jsonIniciar(j, buf, sizeof(buf));
+    jsonTexto(j, "{\"modo\":\"");  jsonTexto(j, energiaModo);
+    jsonTexto(j, "\",\"mhz\":");   jsonInteiro(j, getCpuFrequencyMhz());
+    jsonTexto(j, ",\"tempoMs\":");  jsonInteiro(j, totalMs);
+    jsonTexto(j, ",\"nucleos\":[");
+    float corrente = CORRENTE_AP_MA;
+    for (int n = 0; n < 2; n++) {
+        uint32_t ocioso = min((uint32_t)ociosoMs[n], totalMs);
+        float    fAtivo = totalMs ? (float)(totalMs - ocioso) / totalMs : 1.0f;
+        corrente += fAtivo * (fixo80 ? CORRENTE_ATIVA_80_MA : CORRENTE_ATIVA_MA) +
+                    (1 - fAtivo) * (semDfs ? CORRENTE_OCIOSA_FIXA_MA : CORRENTE_OCIOSA_MA);
+        jsonTexto(j, n ? ",{\"ativoMs\":" : "{\"ativoMs\":");  jsonInteiro(j, totalMs - ocioso);
+        jsonTexto(j, ",\"ociosoMs\":");  jsonInteiro(j, ocioso);
+        jsonTexto(j, ",\"ativoPct\":");  jsonDecimal1(j, fAtivo * 100);
+        jsonTexto(j, "}");
+    }
+    jsonTexto(j, "],\"correnteMa\":");  jsonDecimal1(j, corrente);
+    jsonTexto(j, "}");
+    enviarJson(buf, j.estouro ? 0 : j.len);
+}
+
+/**
+ * GET /api/lcd – tráfego do LCD desde o boot (bytes reais no I2C);
+ * bytesSemDiff é o que a reescrita completa (2 setCursor + 32
+ * caracteres por quadro) teria gasto.
+ */
+void handleLcd() {
+    char    buf[160];
+    JsonBuf j;
+    jsonIniciar(j, buf, sizeof(buf));
+    jsonTexto(j, "{\"quadros\":");      jsonInteiro(j, lcdFlushes);
+    jsonTexto(j, ",\"celulas\":");      jsonInteiro(j, lcdCelulas);
+    jsonTexto(j, ",\"cursores\":");     jsonInteiro(j, lcdCursores);
+    jsonTexto(j, ",\"bytes\":");        jsonInteiro(j, lcdBytesBarramento);
+    jsonTexto(j, ",\"bytesSemDiff\":"); jsonInteiro(j, lcdFlushes * LCD_BYTES_REESCRITA);
+    jsonTexto(j, "}");
+    enviarJson(buf, j.estouro ? 0 : j.len);
+}
+
 void handleNotFound() { server.send(404,"text/plain","Not Found"); }
 
 // ══════════════════════════════════════════════════════════
 //  Registra as rotas do servidor
 // ══════════════════════════════════════════════════════════
 void iniciarWebServer() {
+    static const char* cabecalhos[] = { "If-None-Match" };
+    server.collectHeaders(cabecalhos, 1);
+
     server.on("/",            HTTP_GET,  handleRoot);
     server.on("/api/data",    HTTP_GET,  handleGetData);
+    server.on("/api/stream",  HTTP_GET,  handleStream);
+    server.on("/api/history", HTTP_GET,  handleHistory);
+    server.on("/api/log",     HTTP_GET,  handleLog);
+    server.on("/api/energia", HTTP_GET,  handleEnergia);
+    server.on("/api/lcd",     HTTP_GET,  handleLcd);
     server.on("/api/mode",    HTTP_POST, handleSetMode);
     server.on("/api/relay",   HTTP_POST, handleSetRelay);
     server.on("/api/config",  HTTP_POST, handleSetConfig);
@@ -602,6 +2818,32 @@ void iniciarWebServer() {
     Serial.println("Servidor web iniciado – acesse http://" + WiFi.softAPIP().toString());
 }
 
+/**
+ * Tarefa dedicada ao HTTP/SSE no núcleo 0 – sensores, histérese e LCD
+ * continuam nas tarefas do núcleo 1. SSE e respostas longas saem aos
+ * poucos, sem esperar a janela TCP (ver ClienteSse e ClienteResposta):
+ * um leitor lento não atrasa os outros pedidos.
+ */
+void tarefaWeb(void*) {
+    uint32_t versaoEnviada = versaoEstado();
+    for (;;) {
+        server.handleClient();
+
+        if (versaoEnviada != versaoEstado()) {
+            versaoEnviada = versaoEstado();
+            ssePublicar(false);   // só envia se o JSON mudou
+        }
+        if (millis() - tSse >= TEMPO_SSE_KEEPALIVE) ssePublicar(true);
+        sseServir();    // restos de frames que a janela TCP não aceitou
+        respServir();   // próximos pedaços de /, /api/history e /api/log
+
+        // com cliente no AP, no SSE ou baixando, volta a cada 1 ms (~1000
+        // pedidos/s); sem ninguém, cede mais tempo e deixa o clock cair
+        bool clientes = sseConectados || respAtivas || WiFi.softAPgetStationNum();
+        vTaskDelay(pdMS_TO_TICKS(clientes ? WEB_ESPERA_MS : WEB_ESPERA_OCIOSO_MS));
+    }
+}
+
 // ══════════════════════════════════════════════════════════
 //  SETUP
 // ══════════════════════════════════════════════════════════
@@ -609,43 +2851,51 @@ void setup() {
     Serial.begin(115200);
     Serial.println("\n=== Sistema Estufa Iniciando ===");
 
-    // ── relés: HIGH = desligado (active LOW) ──
-    pinMode(PIN_RELAY_LAMPADA, OUTPUT);
-    pinMode(PIN_RELAY_MOTOR,   OUTPUT);
-    digitalWrite(PIN_RELAY_LAMPADA, HIGH);
-    digitalWrite(PIN_RELAY_MOTOR,   HIGH);
+    // ── relés desligados, LCD, DHT22 e ADC do LDR ──
+    halIniciar();
+    lcdLimpar();
 
     // ── LCD boot ──
-    lcd.init();
-    lcd.backlight();
-    lcd.clear();
-    lcd.setCursor(0,0); lcd.print(pad16("Sistema Estufa"));
-    lcd.setCursor(0,1); lcd.print(pad16("Iniciando AP..."));
+    lcdLinha(0, "Sistema Estufa");
+    lcdLinha(1, "Iniciando AP...");
+    lcdAtualizar();
 
     // ── WiFi Access Point ──
     configurarAP();
+    alocarMemoria();    // depois do AP; a tabela de lux usa a calibração de halIniciar()
+    iniciarEnergia();   // DFS depois do WiFi no ar; contabilidade começa aqui
 
-    // Mostra IP no LCD por 3 s
-    lcd.clear();
-    lcd.setCursor(0,0); lcd.print(pad16("AP: " + String(AP_SSID)));
-    lcd.setCursor(0,1); lcd.print(pad16(WiFi.softAPIP().toString()));
+    // Mostra IP no LCD por 3 s (também cobre a estabilização do DHT22)
+    lcdCampoTexto(lcdLinha(0, "AP:"), 4, 12, AP_SSID);
+    lcdCampoIp(lcdLinha(1, ""), 0, WiFi.softAPIP());
+    lcdAtualizar();
     delay(3000);
-    lcd.clear();
-
-    // ── Web Server ──
-    iniciarWebServer();
 
-    // ── DHT22 ──
-    dht.begin();
-    delay(2000);   // estabilização após power-on
+    // ── sincronização entre tarefas ──
+    filaControle = xQueueCreate(FILA_CONTROLE_TAM, sizeof(MsgControle));
+    publicarEstado();   // leitores já encontram os valores padrão
 
-    // ── primeira leitura ──
-    lerSensores();
-    controlar();
-    mostrarTela();
-
-    tTroca   = millis();
-    tLeitura = millis();
+    // ── Web Server (tarefa própria no núcleo WEB_NUCLEO) ──
+    iniciarWebServer();
+    xTaskCreatePinnedToCore(tarefaWeb, "web", WEB_PILHA, nullptr,
+                            WEB_PRIORIDADE, nullptr, WEB_NUCLEO);
+
+    // ── log persistente (varredura de recuperação antes de qualquer anexo) ──
+    if (iniciarLog())
+        xTaskCreatePinnedToCore(tarefaLog, "log", LOG_PILHA, nullptr,
+                                LOG_PRIORIDADE, nullptr, LOG_NUCLEO);
+
+    // ── controle, display e agenda (a primeira leitura sai na hora) ──
+    xTaskCreatePinnedToCore(tarefaControle, "controle", CTRL_PILHA, nullptr,
+                            CTRL_PRIORIDADE, nullptr, CTRL_NUCLEO);
+    xTaskCreatePinnedToCore(tarefaDisplay,  "display",  DISP_PILHA, nullptr,
+                            DISP_PRIORIDADE, &displayTarefa, DISP_NUCLEO);
+
+    agendar(eventoAmostrar,  PERIODO_AMOSTRA_MS);
+    agendar(eventoGirarTela, TEMPO_TELA, TEMPO_TELA);
+    agendar(eventoLogSerial, TEMPO_LEITURA, TEMPO_LEITURA);
+    xTaskCreatePinnedToCore(tarefaAgenda,   "agenda",   AGENDA_PILHA, nullptr,
+                            AGENDA_PRIORIDADE, nullptr, AGENDA_NUCLEO);
 
     Serial.println("Setup concluido.\n");
 }
@@ -654,32 +2904,6 @@ void setup() {
 //  LOOP PRINCIPAL
 // ══════════════════════════════════════════════════════════
 void loop() {
-    // ── atende requisições HTTP ──
-    server.handleClient();
-
-    unsigned long agora = millis();
-
-    // ── leitura periódica dos sensores (1 s) ──
-    if (agora - tLeitura >= TEMPO_LEITURA) {
-        tLeitura = agora;
-
-        lerSensores();
-        controlar();
-        mostrarTela();
-
-        // debug no Monitor Serie
-        Serial.print("T:");    Serial.print(temperatura, 1);
-        Serial.print(" U:");   Serial.print((int)umidade);
-        Serial.print(" Luz:");  Serial.print(pctLuz);
-        Serial.print(" Lamp:"); Serial.print(lampada ? "ON" : "OFF");
-        Serial.print(" Mot:");  Serial.print(motor   ? "ON" : "OFF");
-        Serial.print(" Modo:"); Serial.println(modoManual ? "MAN" : "AUTO");
-    }
-
-    // ── rotação de telas no LCD (3 telas, 10 s cada) ──
-    if (agora - tTroca >= TEMPO_TELA) {
-        tTroca = agora;
-        tela   = (tela + 1) % 3;
-        mostrarTela();
-    }
+    // todo o trabalho roda nas tarefas criadas em setup()
+    vTaskDelete(nullptr);
 }
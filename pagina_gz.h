@@ -0,0 +1,269 @@
+// Gerado por tools/gerar_pagina.py a partir de web/index.html – NÃO EDITE.
+// Original: 13106 bytes | gzip: 4134 bytes
+#pragma once
+#include <Arduino.h>
+
+#define PAGINA_ETAG "\"3629905f08f65805\""
+
+const size_t  PAGINA_GZ_TAM = 4134;
+const uint8_t PAGINA_GZ[] PROGMEM = {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xb5,0x3b,0xdb,0x6e,0xe3,0xc8,
+    0x95,0xef,0xfe,0x8a,0x1a,0x35,0x7a,0x29,0x4d,0x53,0x57,0xb7,0xdd,0x6e,0xd2,0xf2,
+    0x8c,0xbb,0xdd,0x93,0x74,0xa0,0x9e,0x6e,0xb4,0xed,0x60,0x83,0x20,0x0f,0x25,0xb2,
+    0x24,0x71,0x86,0x64,0x69,0x59,0x45,0xd9,0x6e,0x45,0xc0,0x7c,0x40,0x80,0x00,0xc9,
+    0xcb,0xee,0x62,0x81,0x60,0x92,0x87,0x20,0x79,0x0a,0xb0,0x58,0xec,0x3e,0xed,0x02,
+    0xe3,0x3f,0x99,0x1f,0xd8,0x7c,0xc2,0x9e,0x53,0x55,0xbc,0x48,0xa4,0x64,0xbb,0x67,
+    0x67,0x80,0x36,0xc9,0xe2,0xb9,0xd5,0xb9,0x9f,0xa2,0xe6,0xf8,0x93,0xb3,0xb7,0x2f,
+    0x2f,0x7e,0xf1,0xee,0x15,0x99,0xc9,0x28,0x3c,0xd9,0x3b,0xc6,0x0b,0x09,0x69,0x3c,
+    0x1d,0x36,0xe6,0xb2,0xfd,0xe2,0x7d,0x03,0xd7,0x18,0xf5,0xe1,0x12,0x31,0x49,0x89,
+    0x37,0xa3,0x89,0x60,0x72,0xd8,0xb8,0xbc,0xf8,0xa2,0x7d,0xd4,0xc8,0x96,0x63,0x1a,
+    0xb1,0x61,0x63,0x11,0xb0,0xab,0x39,0x4f,0x64,0x83,0x78,0x3c,0x96,0x2c,0x06,0xb0,
+    0xab,0xc0,0x97,0xb3,0xa1,0xcf,0x16,0x81,0xc7,0xda,0xea,0xc1,0x0e,0xe2,0x40,0x06,
+    0x34,0x6c,0x0b,0x8f,0x86,0x6c,0xd8,0x47,0x1a,0x32,0x90,0x21,0x3b,0x39,0xa3,0x62,
+    0x36,0xe6,0x34,0xf1,0xc9,0x2b,0x21,0xd3,0x09,0x3d,0xee,0xea,0xf5,0xbd,0x63,0x21,
+    0x6f,0xf0,0x4a,0x48,0xf7,0x53,0x22,0x6e,0xff,0x9d,0x4c,0x90,0xbc,0x20,0x3e,0x27,
+    0x22,0x10,0x92,0x45,0xd4,0x21,0x94,0x24,0xcc,0x67,0xb8,0x74,0xfa,0x8e,0xc4,0xb7,
+    0x7f,0xe2,0x04,0xd6,0x49,0x00,0x70,0x49,0xcc,0x24,0x61,0x24,0x8d,0xc8,0xe7,0x41,
+    0x84,0xe2,0x11,0x76,0x8d,0xab,0x00,0x91,0xd0,0x05,0x4d,0x02,0x0a,0xc8,0xf3,0x24,
+    0x88,0x58,0x90,0xc0,0x0d,0xa0,0xa4,0x70,0xfd,0xb4,0x0b,0xec,0x9c,0x84,0x73,0xb9,
+    0x84,0x1b,0x42,0xda,0xed,0xf1,0xd4,0x79,0xd4,0xf3,0xfb,0xfd,0xfe,0x33,0xb7,0xdd,
+    0x16,0x69,0x32,0xa1,0x1e,0x73,0x1e,0xf5,0x0f,0xfb,0xe3,0xc1,0x00,0x56,0xc6,0x3c,
+    0xf1,0x59,0xe2,0x3c,0x1a,0xf4,0x07,0x87,0x03,0xdf,0x35,0x48,0xd3,0x84,0xb1,0xd8,
+    0x79,0xb4,0xff,0xdc,0xdf,0x3f,0xd8,0x77,0xcd,0x73,0xdb,0x0f,0x22,0xc0,0x64,0xcf,
+    0xe8,0x80,0x65,0x80,0x34,0x1a,0x23,0x36,0xdb,0xa7,0xbd,0xfe,0x73,0xd7,0x3c,0x6b,
+    0xc0,0x67,0xf4,0xe0,0xa0,0xdf,0xcb,0x00,0x61,0x9b,0xce,0xa3,0xc9,0xd1,0x41,0xff,
+    0x29,0x82,0xc1,0x53,0x06,0x34,0xe8,0x15,0x40,0x12,0xb6,0xe8,0x3c,0xf2,0x9e,0xfb,
+    0x7d,0x1f,0xa1,0xf0,0x51,0x83,0x1d,0x8d,0x9f,0x3f,0x7d,0xce,0xb2,0xa5,0x71,0x12,
+    0x4c,0x67,0x00,0x38,0xe9,0x4d,0x0e,0x27,0x5e,0xce,0x81,0xfa,0x41,0x2a,0x9c,0x7e,
+    0x6f,0x7e,0x9d,0x2d,0xa1,0xc2,0xdb,0x69,0xe0,0x88,0x1b,0x54,0x37,0xdc,0xd9,0x6d,
+    0x3a,0x9f,0x87,0xac,0xad,0x17,0x6c,0xeb,0x9c,0x4d,0x39,0x23,0x97,0xaf,0x2d,0xfb,
+    0x3d,0x1f,0x73,0xc9,0x6d,0xeb,0xa7,0x2c,0x5c,0x30,0x19,0x78,0x94,0x7c,0xc9,0x52,
+    0x66,0xd9,0xa7,0xa0,0xe8,0xd0,0x16,0x34,0x16,0x6d,0xc1,0x92,0x60,0xb2,0x46,0x5a,
+    0x19,0xda,0x49,0x83,0x76,0xc4,0x63,0x2e,0xe6,0xa0,0x59,0x20,0xf9,0x05,0x79,0x03,
+    0x4f,0x96,0xfd,0x86,0xc5,0x21,0xb7,0x5f,0xf2,0x58,0xf0,0x90,0x0a,0xdb,0xd2,0x1c,
+    0xcc,0x4b,0xeb,0x8c,0x7d,0x45,0x7f,0x9e,0x92,0x73,0x20,0x6c,0x96,0x72,0x1a,0xc8,
+    0x62,0x05,0xff,0x3e,0x5d,0x8e,0xf9,0x75,0x5b,0x04,0x1f,0x82,0x78,0xea,0x68,0x3b,
+    0x81,0xb9,0xae,0xdd,0x88,0x26,0xd3,0x20,0x76,0x7a,0xee,0x9c,0xfa,0x3e,0xbe,0xeb,
+    0x21,0xf4,0x98,0xfb,0x37,0x4b,0x25,0xd5,0x84,0x46,0x41,0x78,0xe3,0x80,0x8f,0x34,
+    0x73,0x15,0xb4,0xdc,0x31,0xf5,0xbe,0x9e,0x26,0x3c,0x8d,0x7d,0xf3,0x66,0x3c,0x6d,
+    0xb9,0x1e,0x0f,0x79,0x62,0x9e,0x51,0xb5,0x2d,0x37,0x0a,0xe2,0xf6,0x8c,0x29,0xfd,
+    0xf6,0x7b,0xbd,0xc5,0x2c,0x67,0x32,0x00,0xbd,0x92,0xfe,0xe1,0xfc,0x7a,0xb5,0x07,
+    0xdc,0x3a,0x33,0x3f,0x59,0x2a,0x63,0xd0,0x30,0x98,0xc6,0x8e,0xc7,0xd0,0x65,0x8d,
+    0x68,0x20,0xa5,0x94,0x3c,0x72,0x06,0x03,0x84,0xd6,0xc0,0x64,0xd6,0xdf,0x26,0x9d,
+    0xd2,0x62,0xcb,0x55,0xf7,0xb0,0x5b,0xe6,0xf4,0x3b,0x83,0x83,0x84,0x45,0x7a,0xe5,
+    0x4a,0x0b,0x73,0xd8,0xeb,0x55,0xa4,0x35,0x8e,0xd0,0x72,0x43,0x26,0x81,0x7b,0x1b,
+    0xb5,0x87,0xa2,0xee,0xcf,0xaf,0x37,0x24,0x39,0x2c,0x09,0xd2,0xc1,0xd0,0x5f,0x16,
+    0xdc,0x3a,0xcf,0x14,0xb3,0x0a,0x71,0x70,0xbc,0xd6,0x3a,0x12,0xe9,0xf8,0x10,0x57,
+    0x7e,0x20,0xe6,0x21,0xbd,0x71,0x82,0x38,0x0c,0x62,0xd6,0x1e,0x87,0xdc,0xfb,0xda,
+    0x55,0x39,0xc2,0x39,0x02,0xc6,0x46,0x79,0x78,0x6b,0x6c,0x66,0x1c,0xf3,0xa0,0xf7,
+    0xb8,0x6a,0x04,0x15,0x58,0xad,0x4c,0x5a,0xed,0xd7,0x07,0x80,0x4a,0xe3,0x20,0xa2,
+    0x32,0xe0,0xb1,0x33,0x4f,0x43,0xc1,0xc8,0x40,0x40,0x52,0x98,0x60,0x0e,0x62,0x28,
+    0xd3,0xe7,0x5f,0xb3,0x9b,0x49,0x02,0xd9,0x4b,0x10,0xf5,0x7e,0xd9,0x7b,0x6c,0x83,
+    0xb9,0x1e,0x2f,0x39,0xaa,0x40,0xde,0x38,0xfd,0xd5,0x41,0xe9,0xa9,0xb3,0xbf,0xd2,
+    0x56,0x8b,0xb8,0x0f,0x12,0xd3,0x24,0xdf,0xc4,0x24,0x64,0xc0,0x0c,0x4d,0xd8,0x06,
+    0xd2,0x91,0xc8,0x0c,0xf9,0x55,0x2a,0x64,0x30,0xb9,0x69,0x9b,0x8c,0x98,0x2d,0x4f,
+    0xe9,0xdc,0xe9,0x0f,0x2a,0xea,0x45,0xdf,0x58,0x95,0xe8,0xfb,0x53,0xb6,0xa6,0xe0,
+    0xa3,0x3a,0x6b,0x66,0x8e,0x75,0x80,0x7e,0xf5,0xb4,0xa2,0x2e,0xa4,0xb9,0x69,0xd8,
+    0x7e,0x85,0x4d,0x87,0xa6,0x92,0x2f,0xeb,0xd5,0xaa,0x2c,0xb8,0x66,0x57,0xad,0xed,
+    0x4d,0x12,0x11,0x8d,0x53,0x1a,0x56,0x89,0xe4,0xb9,0x6c,0x9d,0x88,0x5a,0xd6,0x44,
+    0xc6,0x32,0x6e,0x23,0xa1,0x2a,0xae,0x49,0xb4,0x2d,0xb3,0x29,0x94,0x9c,0x40,0x1e,
+    0x08,0x7c,0x62,0x82,0x4f,0x2d,0xd7,0x05,0xe0,0x7d,0xd4,0x52,0xd1,0xad,0x97,0x26,
+    0x02,0xe8,0xcc,0xb9,0xaa,0x1c,0x2e,0x54,0x88,0x58,0x04,0xca,0x7d,0x3a,0x03,0xb1,
+    0x26,0xaa,0x33,0xe3,0x0b,0x96,0x2c,0x0d,0xd1,0xea,0xbe,0x6a,0xb7,0x8a,0x04,0x3c,
+    0xa8,0x70,0x22,0xf7,0x9b,0x69,0x12,0xf8,0x2e,0xfe,0x01,0xa9,0x23,0x58,0x91,0x0c,
+    0x69,0xa5,0x51,0x2c,0x9c,0x84,0xcd,0x19,0x95,0xcd,0x7d,0xbb,0x3f,0x01,0x72,0xca,
+    0x63,0x7a,0xca,0x63,0xae,0x75,0x25,0x75,0x0e,0x8f,0x7a,0xf3,0x22,0x8b,0x11,0xb4,
+    0x20,0xc9,0x3d,0x08,0xd9,0x7c,0xbc,0x3a,0xd7,0x75,0xa5,0xdf,0xe9,0x87,0x42,0xb1,
+    0x98,0xc3,0x88,0x12,0xa9,0x9a,0xbf,0xe6,0xdc,0xa8,0x2d,0x61,0xb0,0xa7,0x60,0xc1,
+    0x5c,0xd4,0xd6,0x24,0xe4,0x57,0xce,0x2c,0xf0,0x7d,0x16,0x97,0x55,0x5b,0xd6,0x21,
+    0xe9,0xec,0x8b,0x5c,0x7e,0xc7,0x19,0xb3,0x09,0x4f,0xd8,0x32,0x8b,0x1e,0xcb,0x2a,
+    0x28,0xd3,0x31,0x08,0x9e,0x4a,0xe6,0x06,0x31,0x74,0x24,0x90,0xc5,0xf3,0x20,0xed,
+    0x1d,0x96,0xf3,0x03,0x26,0x17,0x9a,0x80,0xcb,0x82,0xf8,0x40,0xa3,0xd9,0xdf,0x3f,
+    0xf0,0xd9,0xd4,0x36,0x86,0xf1,0x50,0xe0,0x96,0xad,0xa4,0x99,0xd3,0x04,0x1f,0x72,
+    0xf6,0xbf,0xf4,0xa9,0xa4,0x5a,0xac,0xa1,0xf2,0xf8,0x5f,0x2d,0x33,0x8c,0xf5,0xac,
+    0x53,0xe3,0x04,0x45,0xe0,0xd4,0x92,0x53,0x0e,0x51,0x21,0x67,0x3c,0x67,0x9b,0x4f,
+    0x6d,0x27,0x07,0x6d,0xc0,0xaf,0x08,0xd9,0x24,0x07,0xab,0x2d,0x17,0x0b,0x5a,0x85,
+    0x9c,0x69,0x1b,0x0a,0x62,0xa4,0x13,0x78,0x7c,0x59,0xae,0x1c,0x2a,0x97,0x57,0xcc,
+    0x58,0x42,0x08,0xc7,0x61,0x39,0x37,0x1d,0xaa,0xf8,0x51,0x9e,0xa0,0x94,0x09,0x76,
+    0x8b,0x9c,0x74,0x3e,0x67,0x89,0x47,0x05,0xab,0x24,0xa0,0x0e,0x26,0xe7,0xda,0x52,
+    0x91,0x39,0x34,0xc6,0x6d,0x8f,0x60,0x09,0xda,0x25,0xc5,0x82,0x86,0x6b,0x62,0x1f,
+    0x3e,0xa8,0xde,0xed,0xa2,0x9c,0x42,0x8d,0xa8,0x6e,0xb0,0x5e,0xe4,0x5d,0x74,0xa0,
+    0x4a,0x40,0x8b,0xb0,0x34,0x89,0x5e,0x72,0x13,0xc6,0xa6,0xbc,0xa9,0xc4,0x54,0xe9,
+    0x28,0x6a,0xa3,0x10,0xcb,0xc5,0x66,0x14,0xdd,0xc5,0x78,0x12,0x84,0xe1,0xb2,0x68,
+    0x43,0x1e,0xd7,0x90,0xdc,0x56,0x4a,0x75,0x8e,0x01,0x94,0x52,0xa4,0xaa,0x35,0xd2,
+    0x39,0x14,0x84,0x81,0x51,0xed,0x02,0x95,0x74,0x9e,0x8a,0x1a,0xd6,0x1d,0xe5,0xb7,
+    0x5b,0x2a,0x42,0xab,0x0e,0x01,0x3c,0x13,0xda,0xc2,0x2a,0x06,0xfa,0xb2,0xce,0x9f,
+    0x82,0x79,0xcb,0x7b,0xe6,0x40,0x00,0x6d,0xcb,0x8f,0x77,0xd2,0xc1,0x56,0x17,0xcd,
+    0x9b,0x48,0x55,0xb5,0xb7,0x25,0x51,0x93,0x28,0x4b,0xbd,0xd3,0x46,0xb9,0xef,0x67,
+    0x82,0xa2,0xf5,0x6e,0x1e,0xdc,0x4b,0xa8,0x26,0xb7,0x3d,0x66,0xf2,0x0a,0x0c,0xe6,
+    0xfe,0xb8,0xb9,0xfe,0xa9,0x69,0x5a,0x37,0x76,0x80,0xdd,0xd9,0x5d,0x99,0x5c,0x6d,
+    0xae,0xc3,0xe3,0xe5,0xdd,0x69,0x52,0x81,0xc2,0x05,0xe7,0xc9,0xb2,0xdd,0x8e,0x2a,
+    0x8d,0xcf,0x41,0xaf,0xb7,0x86,0x41,0x3d,0x14,0x40,0xdc,0xa9,0xc3,0xac,0x8c,0xea,
+    0x5a,0x5e,0x69,0xb0,0x06,0xbb,0x1a,0xac,0xfd,0xac,0xde,0xad,0x6b,0x4c,0xf5,0x71,
+    0x1b,0xae,0x83,0xe9,0xad,0x60,0x01,0x9b,0x27,0x1f,0xd3,0x5b,0x19,0xe4,0xc9,0x64,
+    0xb9,0x35,0x45,0x6c,0xef,0xb6,0xb1,0x51,0xd1,0x7e,0xf5,0x23,0x34,0x55,0xca,0x1d,
+    0x06,0x15,0x55,0x1c,0x6e,0xf4,0x54,0x87,0x77,0xf6,0x54,0x6e,0x66,0xb0,0x98,0xc7,
+    0x6c,0x5d,0x6e,0xd3,0x61,0xe5,0x65,0xfd,0x68,0xfd,0x75,0x07,0x8c,0x4b,0x13,0x95,
+    0x2c,0xb6,0xf8,0xd5,0x76,0xbd,0xe6,0x34,0x7c,0x26,0x14,0x99,0x65,0x7d,0x91,0xc4,
+    0xf2,0xb9,0xb9,0x64,0xba,0xb8,0xc9,0xb4,0x8d,0x6d,0xdb,0x7d,0x1a,0x39,0xe8,0xdf,
+    0x08,0xfc,0x53,0xbe,0x77,0x94,0xb5,0x67,0x80,0x8f,0x8e,0xf9,0x23,0xb7,0x68,0xbd,
+    0x0d,0x76,0x24,0xa4,0x63,0xb6,0x56,0xb7,0x9f,0x6d,0xaf,0x6a,0xd9,0xd6,0xf4,0x64,
+    0xb6,0x1e,0xf8,0x4f,0x37,0x09,0x07,0xf1,0x3c,0x95,0x4b,0x9d,0x94,0x55,0xa5,0x29,
+    0xf7,0xdf,0x47,0xb5,0x9e,0x72,0xd7,0x06,0xef,0x33,0x68,0xe7,0xa5,0xbc,0x9c,0x2d,
+    0x54,0xef,0xc2,0x53,0x89,0xad,0x9f,0x72,0xac,0xed,0x39,0xca,0x74,0xf5,0xeb,0xdb,
+    0x70,0x26,0xdc,0x4b,0xc5,0xf6,0xde,0x7e,0x55,0x78,0x00,0x4f,0xe7,0x6d,0xec,0x84,
+    0x94,0xe5,0xb5,0xc1,0x9d,0x7e,0xb7,0xdd,0x77,0x2b,0x59,0xa5,0x66,0x44,0xd8,0x4c,
+    0x34,0xa5,0x1e,0x01,0xfb,0x82,0xac,0x7e,0x64,0xcf,0x46,0x1e,0xd5,0x42,0xd4,0xeb,
+    0x2c,0xf7,0x6e,0x41,0x17,0xac,0x6c,0x8c,0x72,0xf7,0x51,0x22,0xed,0x3c,0xdf,0xda,
+    0x00,0x94,0x0b,0x5d,0x85,0xdd,0xd6,0xf0,0xda,0xe9,0x95,0x65,0x13,0xd5,0x26,0xda,
+    0xfb,0x4d,0x5f,0xb8,0xb7,0x6c,0xfa,0xda,0xd2,0xbb,0x68,0xc1,0xcc,0x71,0x9d,0x0e,
+    0x58,0xc9,0xa9,0x90,0xcb,0xbc,0x5f,0x9a,0x04,0xd7,0xcc,0x77,0xb3,0xb1,0xfb,0xa9,
+    0xca,0xe0,0x13,0xa9,0xce,0x16,0x8a,0xce,0x40,0xdd,0x61,0x28,0xff,0x63,0xb3,0x0d,
+    0x6f,0x5a,0x24,0x5f,0xf8,0x45,0xf3,0x10,0x42,0xab,0xf5,0xf0,0xa2,0xbb,0x5d,0x73,
+    0x25,0x93,0x90,0xc1,0xe0,0xce,0x79,0xb5,0xf6,0x28,0xa0,0xa4,0xb1,0x7c,0x17,0x58,
+    0x87,0xdd,0x0f,0xed,0x20,0xf6,0xd9,0xb5,0xf3,0xfc,0xb9,0x6b,0xb4,0xdb,0x66,0x0b,
+    0xa8,0x88,0xa2,0xc8,0xbb,0x4a,0x41,0x1d,0x31,0xe3,0x57,0xcb,0xfb,0x69,0xa0,0xa7,
+    0x53,0xe1,0xe7,0x11,0xf3,0x03,0xda,0x2c,0x5a,0xb2,0xa7,0xd8,0x92,0xb5,0xf4,0xb1,
+    0xa9,0x99,0x76,0x77,0xe6,0xc5,0x95,0x81,0xcc,0x32,0xea,0x56,0xe0,0x95,0x3a,0xcf,
+    0x3b,0xee,0x9a,0xe3,0xe0,0xe3,0xae,0x39,0x99,0xc6,0x13,0xbb,0x93,0xbd,0xbd,0x63,
+    0x3f,0x58,0x10,0x2f,0xa4,0x42,0x0c,0x1b,0x33,0x3f,0x69,0xe0,0x81,0xf1,0xf1,0xac,
+    0x7f,0xf2,0xf7,0x3f,0xfc,0xe6,0x7f,0xc8,0xab,0xf3,0x8b,0xcb,0x2f,0x4e,0x01,0xa5,
+    0xaf,0x96,0x4b,0xa0,0x78,0x20,0xd5,0x38,0x39,0x86,0xca,0x1d,0x67,0x4b,0x3e,0x97,
+    0xb0,0xd2,0xc5,0xa5,0x93,0x97,0xa0,0x1f,0x4f,0x52,0x9f,0x93,0x7f,0x88,0xc7,0x62,
+    0xee,0xfe,0x5a,0x5f,0xc8,0xeb,0x77,0x0e,0xd1,0x48,0x81,0x3f,0x6c,0x04,0xf3,0x53,
+    0x1f,0x59,0x7e,0xff,0xcd,0xef,0x0d,0xde,0x06,0x78,0x01,0x9a,0xce,0xfd,0x32,0xdc,
+    0x71,0x17,0x64,0xc1,0xcd,0xa8,0xcb,0xda,0x26,0xb2,0x43,0x26,0xbd,0x93,0xb2,0x80,
+    0xc5,0xa1,0x8b,0xea,0x78,0x1b,0x8a,0x30,0x2e,0xbe,0xc0,0xb5,0xc6,0xc9,0xe9,0xe5,
+    0xc5,0x5b,0x43,0x1f,0x51,0xc7,0x29,0xb8,0x79,0x8e,0x9c,0x9d,0x60,0x94,0xb0,0x64,
+    0xdc,0x20,0x3c,0xf6,0xc2,0xc0,0xfb,0x7a,0xd8,0x90,0x7c,0x3a,0x0d,0xd9,0x1b,0x58,
+    0x6f,0xb6,0x80,0x14,0x4c,0x15,0x50,0x66,0xdf,0xa8,0xb3,0x9d,0xe3,0xae,0x26,0x55,
+    0x2f,0xaf,0xb2,0x75,0x63,0x53,0xbf,0xb8,0xaa,0x59,0xe1,0xdd,0x05,0xd8,0xb5,0x41,
+    0x4a,0xa3,0x6b,0x43,0xb9,0xbf,0xc2,0x5a,0xc7,0x83,0x81,0xb4,0x81,0xb6,0xfb,0xf6,
+    0x7f,0xff,0xeb,0xb7,0x86,0xdb,0x26,0x08,0x24,0xde,0xc6,0x09,0x52,0x64,0x09,0xc5,
+    0x53,0xfb,0x2d,0x60,0x30,0x23,0x6a,0x01,0x16,0x8a,0xbb,0x56,0x7e,0x2d,0x24,0xce,
+    0x7c,0x8d,0x93,0xef,0xfe,0xf6,0x72,0xcb,0x7b,0x3d,0xcb,0x81,0x6f,0x6c,0xac,0xe1,
+    0xe8,0xa2,0x59,0xc0,0x93,0x66,0xa2,0x29,0xe4,0x74,0x8a,0x9b,0xad,0xaa,0xb9,0x8c,
+    0x02,0xff,0x41,0xaa,0xf9,0xdd,0x9f,0x77,0xe9,0x05,0xc9,0x51,0x9f,0xdd,0xa9,0x13,
+    0xc5,0xf6,0x4e,0x9d,0x3c,0xfe,0x21,0x1a,0xd1,0x2c,0x1e,0xae,0x91,0x51,0xfa,0xe1,
+    0x01,0x0a,0xf9,0xfe,0x9f,0xbf,0xb9,0xc3,0x55,0x46,0x69,0x14,0xc4,0x50,0x01,0xee,
+    0xa5,0x17,0x64,0x7e,0x97,0x5a,0x74,0x40,0x2b,0xc8,0x1f,0xa4,0x20,0x45,0xa1,0x5e,
+    0x3f,0x75,0x81,0x06,0x73,0x6d,0x25,0xcc,0xd4,0xac,0xdb,0x38,0x79,0xcf,0xc2,0xdb,
+    0xbf,0x88,0x5a,0xdd,0xaa,0x8e,0x57,0xb3,0x4c,0xf8,0xd5,0x88,0xa2,0x97,0x6a,0x71,
+    0xcb,0xa9,0x45,0xcd,0x5e,0xca,0xbb,0xbe,0x25,0xa3,0xdb,0x3f,0x46,0x50,0x96,0x28,
+    0xf9,0x09,0x20,0x14,0xf9,0x64,0x83,0xac,0x19,0xbd,0x0c,0xb1,0x0d,0x72,0x3a,0x49,
+    0xc1,0x08,0x63,0xf6,0xaa,0xd9,0x9e,0xbd,0x3a,0x1f,0xbd,0xfe,0x49,0xa7,0x4c,0xb2,
+    0x36,0x4d,0x95,0x44,0x86,0x47,0x8d,0x5b,0xe4,0x20,0x85,0xb4,0xd3,0x9d,0xd6,0xb7,
+    0xfc,0x06,0xd3,0xfa,0x8e,0x1d,0xff,0xe6,0x1b,0x02,0x20,0xd0,0x15,0x76,0xc9,0xcf,
+    0xa1,0x36,0x06,0x21,0x64,0xfd,0xe4,0xff,0x67,0xdb,0x8a,0xf5,0xc7,0xed,0xfa,0x8d,
+    0x2e,0x46,0xbb,0x36,0xfd,0x40,0x1f,0xf9,0xfe,0x5f,0xff,0x05,0x02,0x85,0x8c,0x82,
+    0x28,0xa0,0x09,0x13,0x04,0x9c,0x9c,0x40,0x19,0xe0,0xaa,0x96,0x44,0xb7,0xdf,0x4a,
+    0x08,0xa7,0xfa,0xe8,0x34,0x25,0xba,0x26,0x02,0xd7,0xba,0xe1,0x1d,0xca,0xac,0x8d,
+    0x91,0xac,0xfb,0x86,0x7d,0xaa,0xf9,0xa4,0x9c,0xd3,0x89,0x1e,0xf3,0x9a,0x90,0x94,
+    0x5b,0xc7,0x5d,0xfd,0xfa,0x58,0x75,0xe9,0x44,0xde,0xcc,0xd9,0xb0,0x11,0xa7,0xd8,
+    0x4c,0x9b,0xa4,0x71,0x31,0x6a,0x10,0x21,0xd9,0x7c,0xd8,0xe8,0x75,0x0e,0x1a,0x27,
+    0x1f,0xc3,0x2f,0x1b,0x09,0xef,0xcd,0xf2,0xec,0xa3,0x58,0x9a,0xf4,0x9c,0x6d,0xef,
+    0xf1,0x3d,0x38,0x5d,0xe6,0x9b,0xeb,0x3f,0x9c,0x4f,0xb1,0xad,0x7b,0xb1,0x3a,0xbb,
+    0x1f,0xab,0x35,0x93,0x57,0x33,0xc6,0xfd,0x44,0x2c,0xa7,0xe5,0x87,0xe8,0x63,0xf4,
+    0x31,0xfa,0x58,0x63,0xf6,0x30,0xa5,0x8c,0x6a,0x95,0x52,0xdc,0x54,0x23,0x19,0x47,
+    0x95,0x52,0x67,0x85,0x8f,0xd0,0x4f,0x4e,0x82,0x29,0x76,0x56,0xa0,0xb0,0xff,0x26,
+    0xe7,0x34,0xc4,0xf6,0xca,0x53,0xab,0xe0,0x7e,0xb7,0x7f,0xbe,0xfd,0x0f,0x26,0x76,
+    0xf7,0x59,0xaa,0x53,0xd7,0x32,0xe9,0xdb,0x13,0xa4,0xc2,0x73,0x50,0xe1,0x25,0xc1,
+    0x5c,0x9e,0xec,0x85,0x4c,0x92,0x40,0xe8,0xce,0x6d,0x38,0xa1,0xa1,0x60,0xee,0xde,
+    0xde,0x24,0x8d,0x55,0xe2,0x22,0x74,0x0e,0x42,0xc1,0x00,0xe2,0xab,0x56,0xdd,0x87,
+    0x89,0x37,0x82,0x38,0xed,0x4c,0x99,0x7c,0x15,0x32,0xbc,0x7d,0x71,0xf3,0xda,0x6f,
+    0x5a,0xaa,0x67,0xb2,0x5a,0x1d,0x1c,0xb6,0x5f,0x9a,0x9f,0x75,0xf8,0x1d,0x6c,0xcf,
+    0x3f,0xfb,0xcc,0x6a,0xb7,0x2d,0x17,0x14,0xde,0xed,0x92,0x38,0x0d,0x43,0x42,0xe5,
+    0xed,0x5f,0x08,0x25,0xfd,0xef,0xfe,0x4a,0x42,0x16,0xe8,0x68,0xe2,0xe4,0xec,0xa7,
+    0x17,0x83,0xc1,0x4e,0x16,0xe8,0xa3,0x15,0x16,0x60,0x27,0xdf,0xb0,0xd8,0x89,0x0c,
+    0xb5,0xb3,0x82,0x1b,0xa6,0x1f,0x76,0x22,0xa5,0x55,0x24,0xeb,0x31,0xf9,0xee,0x3f,
+    0x89,0xf5,0x04,0x91,0xaf,0x9f,0x58,0x04,0xfe,0x2a,0xc6,0xd0,0xae,0xc3,0x18,0xf2,
+    0x02,0x14,0x65,0x99,0xde,0xce,0xb2,0xad,0xac,0x93,0xb5,0x6c,0xad,0x0a,0x7b,0xf0,
+    0xcc,0xde,0xef,0xb5,0xaa,0xf0,0x6a,0x67,0x1a,0x5e,0xdf,0xea,0x7d,0xd9,0x87,0x3d,
+    0xfb,0x59,0x1d,0x3c,0xca,0xa5,0xc1,0xd5,0x9d,0xda,0x89,0xbd,0x7f,0x60,0x3f,0x3b,
+    0xc8,0x80,0xdf,0x63,0x71,0x68,0x5a,0xa6,0x82,0x03,0xf0,0x38,0xbb,0xea,0x02,0xa9,
+    0x90,0xa8,0x0a,0x42,0xdb,0xc2,0x1b,0xab,0x8a,0x09,0x89,0x19,0x11,0xcc,0x45,0x95,
+    0x18,0x44,0x8b,0x30,0x5f,0xdb,0x96,0xba,0x68,0xac,0xdc,0x7b,0xf0,0xa5,0xcf,0xcd,
+    0xc3,0x70,0xd8,0x2f,0x24,0xc7,0x39,0xe1,0xf2,0x75,0x53,0x81,0x0b,0x26,0x5f,0x4f,
+    0x5e,0x84,0x29,0xec,0x05,0x32,0x71,0xa6,0x9c,0x11,0x46,0x58,0xf5,0xfd,0x59,0xf6,
+    0xfe,0x4c,0x05,0x61,0x05,0xe0,0x72,0x94,0x69,0xab,0x9e,0xc0,0xe5,0x59,0xf6,0x7e,
+    0x0b,0x81,0xd1,0xc8,0x28,0xb0,0x1e,0x7f,0x74,0x66,0x5e,0x97,0xd0,0xb7,0x3b,0xcc,
+    0x7c,0xd3,0x41,0x63,0x76,0x45,0xce,0x60,0xff,0x4d,0x58,0xe6,0x23,0x8e,0x3f,0x66,
+    0xba,0x08,0x22,0x76,0x2e,0x13,0x18,0xe2,0x51,0x1d,0x30,0x1c,0x53,0x71,0x13,0x7b,
+    0x24,0x8f,0xb8,0x39,0x0f,0xc3,0xa6,0x8a,0x36,0x99,0xdc,0xe8,0xf9,0x18,0xe2,0x5e,
+    0x48,0x92,0x0c,0xe9,0x15,0x0d,0x24,0x99,0x30,0xe9,0xcd,0x9a,0x56,0x97,0xce,0x83,
+    0x2e,0xb6,0xbd,0xda,0x08,0x24,0x0f,0x55,0x0d,0x95,0x74,0xbe,0x12,0x3c,0x6e,0xb6,
+    0xd4,0xcb,0x95,0x47,0x11,0x87,0xb5,0x96,0x2b,0xe4,0x08,0x91,0x38,0x4f,0xc5,0x8c,
+    0x2c,0x02,0x4a,0xce,0x59,0xb2,0x80,0x39,0xff,0x1c,0xa4,0x25,0xaf,0xd4,0xb0,0xef,
+    0x82,0x02,0x08,0x87,0x3f,0xc9,0x22,0x80,0x6a,0x4c,0x12,0xe6,0xa5,0x02,0xb3,0x5f,
+    0xc8,0x71,0xc2,0x6d,0x91,0x05,0x0f,0x25,0x25,0x94,0x2b,0x51,0x61,0x1f,0x2a,0x85,
+    0xe0,0x3d,0x6e,0x2d,0x19,0x62,0x90,0xbb,0x45,0x06,0xf1,0xf4,0x68,0x9c,0xe8,0x3d,
+    0x05,0x93,0xe6,0x27,0x57,0x41,0xec,0xf3,0xab,0x8e,0xe2,0x76,0xce,0xd3,0xc4,0x03,
+    0xb9,0x0a,0x74,0xd4,0x3e,0x1e,0x3d,0x40,0x8f,0xdd,0xc4,0x55,0xbb,0x3f,0xe8,0x41,
+    0x10,0x24,0x0c,0x32,0x45,0xec,0xe2,0x74,0xaf,0xd5,0xc1,0x84,0xd2,0x6e,0x89,0x8a,
+    0xd1,0x89,0x90,0x09,0xa3,0x91,0xd6,0x0a,0x13,0x1d,0x1e,0x47,0x4c,0x08,0x3a,0x65,
+    0x43,0x36,0x3c,0x59,0xa2,0x4e,0x33,0x45,0xfd,0xec,0xfc,0xed,0x97,0x9d,0x39,0xfe,
+    0x54,0xad,0xc9,0x3a,0xa8,0x49,0x50,0x96,0xd1,0xd4,0x35,0x68,0x6a,0x95,0x13,0x60,
+    0x49,0x02,0x73,0x45,0xb3,0x05,0xf8,0x4a,0xd3,0xb0,0x09,0x58,0x07,0x2e,0xfe,0xcd,
+    0xb9,0x04,0xeb,0x7e,0x32,0x1c,0x96,0xc4,0xe8,0xbc,0x1c,0xbd,0x3d,0x7f,0x75,0xd6,
+    0x22,0x46,0x64,0x93,0xfa,0x20,0xab,0x4f,0xb1,0xbb,0x21,0x5f,0xdd,0x7e,0x8b,0x3a,
+    0xd5,0x6a,0x21,0x82,0x7f,0x08,0xe2,0x19,0xcf,0xe8,0x7e,0x92,0x2b,0xa2,0x45,0xee,
+    0xd4,0x89,0x42,0x82,0x77,0x08,0xc4,0x53,0xd9,0x54,0x12,0x7a,0x21,0xa3,0xc9,0x1a,
+    0xb4,0x26,0xe7,0x6e,0x58,0xa8,0xb0,0x8b,0xbb,0xb2,0xfb,0x07,0x3d,0x43,0x70,0x85,
+    0x3e,0xa9,0x7d,0xd0,0xdd,0x2b,0xc1,0x94,0x6a,0x42,0x11,0x1f,0x90,0xa3,0x16,0xca,
+    0xac,0xc6,0x24,0x90,0x02,0xb6,0xc4,0x46,0xe0,0xeb,0x54,0x31,0x69,0xe6,0x10,0xd8,
+    0x1a,0x2f,0x98,0x01,0x02,0x15,0xb2,0xb0,0x05,0x14,0xf0,0x5b,0x6d,0xca,0x86,0x0b,
+    0x15,0x1a,0x39,0xcb,0x22,0xff,0x41,0xfa,0x7b,0xed,0xdb,0x98,0xfb,0xe0,0x02,0xb0,
+    0xf6,0x15,0x4d,0x62,0xdb,0xa7,0xf1,0x14,0xf6,0xb8,0xab,0x46,0x29,0xc4,0x56,0x47,
+    0x1d,0x0b,0x75,0xf4,0x2f,0x0e,0xdf,0x50,0x39,0xeb,0x40,0xa1,0x6f,0x22,0x9d,0x3e,
+    0x28,0xe0,0x89,0xf5,0x78,0x67,0x1d,0x31,0x34,0x54,0x85,0xfd,0x12,0x7f,0xcd,0x68,
+    0x65,0x43,0x9a,0xf5,0x04,0x89,0x9c,0x0c,0xb5,0x20,0x9f,0x59,0xf8,0x43,0x43,0xcb,
+    0x51,0x4b,0x28,0x20,0x2c,0xa8,0xd3,0x5c,0xcb,0xb1,0xac,0x9d,0x39,0x44,0x6f,0xac,
+    0xa5,0xdc,0x11,0xf4,0xdc,0xd1,0x23,0xed,0x1a,0xe9,0x4d,0xca,0x19,0x61,0x35,0xf6,
+    0x5a,0x15,0xbd,0xe9,0x84,0x0e,0xf9,0x1c,0xf4,0xa5,0x06,0x0e,0xbc,0xca,0x18,0xfe,
+    0x0a,0xf4,0x5d,0xdb,0x9b,0x95,0x2c,0xc8,0xe3,0xa1,0x5a,0xcd,0xb2,0xb7,0xc9,0x3c,
+    0xfc,0x6a,0xab,0x61,0x15,0xe1,0x56,0x01,0xab,0x58,0x0c,0xb7,0x2b,0x50,0x09,0x50,
+    0x86,0x97,0xf1,0x76,0x68,0x14,0x53,0xc1,0x02,0x97,0xb2,0xd6,0xd5,0xec,0x03,0x2a,
+    0xe7,0xa8,0x58,0x1e,0xe7,0x5a,0xd5,0x9f,0xc2,0xca,0x09,0x18,0x21,0x60,0x9c,0x3a,
+    0x3d,0x7b,0x0b,0x40,0x66,0xb4,0xb2,0x0a,0xd0,0x35,0x4b,0xe2,0x30,0x66,0x88,0x2a,
+    0x9a,0x30,0x98,0x59,0x99,0xd7,0x66,0x35,0xce,0x9c,0x58,0x82,0x64,0xc6,0x93,0xcc,
+    0xe7,0x8f,0xa1,0x55,0xfe,0x81,0x9a,0xe5,0xe6,0x50,0x9b,0xc2,0x9c,0x99,0x66,0x12,
+    0xe8,0xab,0x8a,0x53,0x02,0x2d,0x0b,0x93,0x0d,0x78,0x99,0x40,0x7e,0x81,0xa6,0xaf,
+    0xad,0x02,0x2f,0xeb,0x1c,0x31,0xfc,0xc1,0x67,0xb4,0xc1,0xbd,0x99,0x0d,0x78,0x3d,
+    0xa7,0xaf,0xa3,0x1a,0x22,0x0b,0xb2,0x7a,0x8d,0xd8,0x78,0xb2,0x6b,0xd5,0x05,0x5b,
+    0x56,0xb2,0x0b,0xe7,0x18,0x6f,0x35,0x94,0x95,0x9f,0x2a,0x5a,0xf7,0x34,0xad,0x65,
+    0x4e,0x14,0x6b,0x14,0x3c,0x5e,0xef,0xb8,0xde,0x9c,0x7e,0x79,0x79,0x3a,0xb2,0xdc,
+    0x71,0x59,0x3f,0xa5,0xa3,0x4d,0xfd,0x7b,0x32,0x78,0xbf,0xa1,0x6c,0xcb,0x9c,0x49,
+    0x9e,0xc2,0xb8,0x6a,0xa9,0xba,0xa1,0x54,0x60,0xfe,0xdb,0xe4,0x82,0x67,0xa1,0xd8,
+    0xa5,0x6e,0xe3,0x42,0x15,0x95,0xaa,0x49,0xad,0xb5,0x93,0x4f,0xe4,0x53,0xad,0xe8,
+    0xe5,0xa3,0xd2,0x25,0xd1,0xe5,0x79,0xce,0x85,0xd4,0x4a,0xb0,0xec,0xa5,0xfa,0xa5,
+    0x58,0xa6,0x00,0xb4,0xd9,0xaa,0xe5,0x92,0xd5,0x26,0x99,0xb2,0x69,0x85,0xdc,0xa0,
+    0xa4,0x23,0xc2,0x5e,0x7a,0x33,0x1a,0xc7,0x2c,0x74,0x14,0x0c,0x58,0xd1,0x11,0x52,
+    0x13,0xab,0x50,0x2b,0x4d,0x19,0x85,0x89,0x65,0x38,0x7c,0xb2,0xd5,0x64,0xd8,0xad,
+    0xb5,0x74,0x7e,0x2e,0x8c,0x2c,0xfd,0x9d,0x18,0x67,0x65,0x0c,0x30,0xb3,0xf4,0x4f,
+    0x86,0x12,0x8c,0x8c,0x5f,0x10,0x2e,0x70,0x2c,0x69,0x5a,0xd8,0x22,0x17,0x33,0x96,
+    0xcf,0x16,0x0c,0x7b,0x0f,0x02,0x54,0xa0,0x58,0xfe,0x53,0x6a,0x86,0x3d,0xcb,0x96,
+    0x49,0xca,0x6a,0xfa,0x80,0x74,0xa7,0xc8,0x97,0x35,0x22,0xa7,0x3b,0x45,0xbe,0xdc,
+    0x14,0x39,0x05,0x91,0xd3,0x75,0x91,0xb1,0x4b,0xff,0x01,0x22,0x87,0x3b,0x45,0x1e,
+    0xd5,0x88,0x1c,0xee,0x14,0x79,0xb4,0x29,0x72,0xe8,0x1f,0x0f,0xc3,0x75,0x91,0x61,
+    0x52,0xa8,0x93,0x98,0x06,0x77,0x48,0x5c,0x76,0x32,0x3d,0x7f,0x82,0x97,0xe5,0x0d,
+    0xbb,0x23,0x43,0xbb,0xe8,0xce,0x1d,0xe9,0xdb,0x79,0x2b,0xee,0xa4,0xa1,0x5d,0xf4,
+    0xdd,0x4e,0xea,0xdb,0x59,0x93,0xed,0x40,0x03,0x93,0x77,0xd4,0x4e,0xe8,0xaf,0x74,
+    0xd7,0x5d,0xc8,0xfa,0x72,0x7d,0xce,0x05,0x5f,0x85,0xf1,0x57,0x90,0xef,0xff,0xed,
+    0xf7,0xd6,0x96,0x96,0x19,0xb0,0x58,0xec,0xab,0x8f,0x56,0xb6,0xea,0xe4,0xee,0xd9,
+    0x3f,0x5b,0x4f,0x72,0xb4,0x65,0xc4,0xe4,0x8c,0xfb,0x8e,0xf5,0xee,0xed,0xf9,0x85,
+    0x65,0xe3,0x57,0x23,0x96,0x08,0x67,0x69,0x99,0x50,0x6f,0x5f,0xc0,0xac,0x0f,0xe9,
+    0x17,0x7f,0xd2,0x0e,0xed,0x23,0x32,0xee,0x5e,0xb7,0xaf,0xae,0xae,0xda,0xf8,0x0d,
+    0xac,0x9d,0x26,0x21,0x8b,0x3d,0x08,0x64,0xdf,0x5a,0xd9,0xf8,0xad,0xc9,0xc1,0xee,
+    0xf4,0xf2,0xfd,0xe8,0x1c,0xda,0x31,0x6f,0xf6,0x8e,0x26,0x34,0x12,0x4d,0x25,0x1b,
+    0x8c,0x02,0xd9,0x00,0xb0,0x32,0x69,0x5c,0x2b,0x9c,0xac,0xb7,0xee,0xeb,0x9d,0x7b,
+    0x49,0x3f,0xaf,0xa0,0x1f,0x05,0x1b,0xc2,0xbe,0xa2,0x34,0x06,0x59,0x40,0x4d,0x7f,
+    0xe2,0x99,0xed,0x56,0x6b,0xb9,0xbc,0xc0,0x8a,0xc4,0xd4,0x0e,0x04,0xa0,0x96,0xc3,
+    0x7d,0x7b,0x7e,0x56,0x67,0x06,0x3a,0x3b,0xcb,0xb5,0x8c,0x07,0x74,0xf4,0xa2,0x2e,
+    0x24,0xfa,0xfb,0xe3,0x4b,0xd5,0xa6,0x28,0xf2,0x9f,0x59,0xc5,0xaf,0x20,0x40,0x5d,
+    0xe5,0xaf,0x97,0x56,0x19,0xd1,0x7b,0x08,0x8a,0x4a,0xca,0xa3,0x40,0x40,0xd7,0xe8,
+    0x83,0x70,0xb8,0x2b,0x2b,0x9b,0xd5,0xca,0xdd,0x6f,0x19,0x32,0x61,0x11,0x5f,0xb0,
+    0x0c,0xd8,0x1e,0xe8,0x96,0x19,0x94,0xb3,0x75,0xcf,0xfa,0xfb,0xdc,0xc6,0x08,0x67,
+    0xa6,0x15,0x28,0xeb,0xca,0xe6,0x9d,0x19,0x38,0x1b,0x9e,0x05,0xbb,0xf8,0x8d,0xd1,
+    0x9c,0xa1,0x1c,0x77,0xf5,0xd7,0xc5,0xe3,0xae,0xfe,0x3f,0x64,0xfe,0x0f,0x5b,0x8c,
+    0x29,0xd8,0x32,0x33,0x00,0x00,
+};
@@ -0,0 +1,250 @@
+/*
+ * Varredura de limiares sobre o modelo da estufa – usa todos os núcleos do PC.
+ *
+ * Cada combinação (tempLigar, tempDeslig, umidLigar, umidDeslig, luzLigar,
+ * luzDeslig) da grade roda em tools/planta.h com a histérese do firmware;
+ * o resultado é a fronteira de Pareto entre desgaste dos relés (número de
+ * acionamentos), horas fora da faixa de conforto e energia. Os valores
+ * escolhidos podem ser enviados para POST /api/config.
+ *
+ * Compilar (na raiz do repositório):
+ *
+ *     g++ -O2 -std=c++17 -pthread tools/ajustar_limiares.cpp -o ajustar_limiares
+ *
+ * Uso:
+ *
+ *     ./ajustar_limiares [--dias N] [--passo S] [--semente N] [--clima arq.csv]
+ *                        [--faixa tMin,tMax,uMin,uMax] [--threads N] [--csv saida.csv]
+ *                        [--tempLigar ini:fim:passo] [--tempDeslig ...] [--umidLigar ...]
+ *                        [--umidDeslig ...] [--luzLigar ...] [--luzDeslig ...]
+ *
+ * Combinações com "desliga" >= "liga" são descartadas antes de simular.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "planta.h"
+
+// ──────────────────────────────────────────────────────────
+//  GRADE
+// ──────────────────────────────────────────────────────────
+struct Faixa { float ini, fim, passo; };
+
+static std::vector<float> valores(const Faixa& f) {
+    std::vector<float> v;
+    for (int i = 0; ; i++) {
+        float x = f.ini + i * f.passo;
+        if (x > f.fim + f.passo * 1e-3f) break;
+        v.push_back(x);
+        if (f.passo <= 0) break;
+    }
+    return v;
+}
+
+static std::vector<Limiares> montarGrade(const Faixa f[6]) {
+    std::vector<float> tl = valores(f[0]), td = valores(f[1]), ul = valores(f[2]),
+                       ud = valores(f[3]), ll = valores(f[4]), ld = valores(f[5]);
+    std::vector<Limiares> g;
+    for (float a : tl) for (float b : td) if (b < a)
+    for (float c : ul) for (float d : ud) if (d < c)
+    for (float e : ll) for (float h : ld) if (int(h) > int(e))
+        g.push_back({ a, b, c, d, int(e), int(h) });
+    return g;
+}
+
+// ──────────────────────────────────────────────────────────
+//  POOL COM ROUBO DE TRABALHO
+//  A grade é dividida em blocos distribuídos entre as filas dos
+//  threads. Cada um consome do fim da própria fila e, quando ela
+//  esvazia, rouba do início da fila de outro – combinações com
+//  mais acionamentos custam mais e o balanceamento se ajusta.
+// ──────────────────────────────────────────────────────────
+struct Bloco { size_t ini, fim; };
+
+class PoolRoubo {
+public:
+    explicit PoolRoubo(unsigned n) : filas(n) {}
+
+    void distribuir(size_t total, size_t tamBloco) {
+        unsigned i = 0;
+        for (size_t ini = 0; ini < total; ini += tamBloco, i = (i + 1) % filas.size())
+            filas[i].d.push_back({ ini, std::min(total, ini + tamBloco) });
+    }
+
+    template <class F>
+    void executar(F trabalho) {
+        std::vector<std::thread> th;
+        for (unsigned id = 0; id < filas.size(); id++)
+            th.emplace_back([this, id, &trabalho] {
+                Bloco b;
+                while (pegar(id, b)) trabalho(b);
+            });
+        for (auto& t : th) t.join();
+    }
+
+    std::atomic<uint32_t> roubos{0};
+
+private:
+    struct Fila { std::mutex m; std::deque<Bloco> d; };
+    std::vector<Fila> filas;
+
+    bool pegar(unsigned id, Bloco& b) {
+        {   // própria fila – pelo fim
+            std::lock_guard<std::mutex> g(filas[id].m);
+            if (!filas[id].d.empty()) { b = filas[id].d.back(); filas[id].d.pop_back(); return true; }
+        }
+        for (unsigned k = 1; k < filas.size(); k++) {   // rouba pelo início
+            Fila& v = filas[(id + k) % filas.size()];
+            std::lock_guard<std::mutex> g(v.m);
+            if (!v.d.empty()) { b = v.d.front(); v.d.pop_front(); roubos++; return true; }
+        }
+        return false;   // nenhuma tarefa nova nasce durante a execução: acabou
+    }
+};
+
+// ──────────────────────────────────────────────────────────
+//  FRONTEIRA DE PARETO (minimiza os três objetivos)
+// ──────────────────────────────────────────────────────────
+struct Avaliacao { Limiares cfg; uint32_t trocas; float foraH, energiaKwh; };
+
+static bool domina(const Avaliacao& a, const Avaliacao& b) {
+    bool menorOuIgual = a.trocas <= b.trocas && a.foraH <= b.foraH && a.energiaKwh <= b.energiaKwh;
+    bool estrito      = a.trocas <  b.trocas || a.foraH <  b.foraH || a.energiaKwh <  b.energiaKwh;
+    return menorOuIgual && estrito;
+}
+
+static std::vector<Avaliacao> fronteira(std::vector<Avaliacao> v) {
+    // ordenado por acionamentos: só quem vem antes pode dominar
+    std::sort(v.begin(), v.end(), [](const Avaliacao& a, const Avaliacao& b) {
+        if (a.trocas != b.trocas) return a.trocas < b.trocas;
+        if (a.foraH  != b.foraH)  return a.foraH  < b.foraH;
+        return a.energiaKwh < b.energiaKwh;
+    });
+    std::vector<Avaliacao> f;
+    for (const Avaliacao& a : v) {
+        bool dominado = false;
+        for (const Avaliacao& x : f) if (domina(x, a) || (x.trocas == a.trocas && x.foraH == a.foraH &&
+                                                          x.energiaKwh == a.energiaKwh)) { dominado = true; break; }
+        if (!dominado) f.push_back(a);
+    }
+    std::sort(f.begin(), f.end(), [](const Avaliacao& a, const Avaliacao& b) { return a.foraH < b.foraH; });
+    return f;
+}
+
+// ──────────────────────────────────────────────────────────
+static void uso() {
+    fprintf(stderr,
+        "uso: ajustar_limiares [--dias N] [--passo S] [--semente N] [--clima arq.csv]\n"
+        "                      [--faixa tMin,tMax,uMin,uMax] [--threads N] [--csv saida.csv]\n"
+        "                      [--tempLigar ini:fim:passo] [--tempDeslig ...] [--umidLigar ...]\n"
+        "                      [--umidDeslig ...] [--luzLigar ...] [--luzDeslig ...]\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    Cenario cen;
+    cen.dias  = 14;
+    cen.passo = 5;
+    ParamPlanta planta;
+    const char* arqClima = nullptr;
+    const char* arqCsv   = nullptr;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    static const char* NOMES[6] = { "--tempLigar", "--tempDeslig", "--umidLigar",
+                                    "--umidDeslig", "--luzLigar",  "--luzDeslig" };
+    Faixa grade[6] = { { 26, 32, 1 }, { 24, 31, 1 }, { 65, 80, 5 },
+                       { 55, 75, 5 }, { 15, 30, 5 }, { 20, 40, 5 } };
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (i + 1 >= argc) uso();
+        const char* v = argv[++i];
+        int g = -1;
+        for (int k = 0; k < 6; k++) if (!strcmp(a, NOMES[k])) g = k;
+
+        if (g >= 0) {
+            if (sscanf(v, "%f:%f:%f", &grade[g].ini, &grade[g].fim, &grade[g].passo) != 3) uso();
+        }
+        else if (!strcmp(a, "--dias"))    cen.dias    = strtoul(v, nullptr, 10);
+        else if (!strcmp(a, "--passo"))   cen.passo   = strtoul(v, nullptr, 10);
+        else if (!strcmp(a, "--semente")) cen.semente = strtoul(v, nullptr, 10);
+        else if (!strcmp(a, "--threads")) threads     = std::max(1ul, strtoul(v, nullptr, 10));
+        else if (!strcmp(a, "--clima"))   arqClima    = v;
+        else if (!strcmp(a, "--csv"))     arqCsv      = v;
+        else if (!strcmp(a, "--faixa")) {
+            if (sscanf(v, "%f,%f,%f,%f", &cen.tempMin, &cen.tempMax, &cen.umidMin, &cen.umidMax) != 4) uso();
+        } else uso();
+    }
+    if (cen.dias == 0 || cen.passo == 0) uso();
+
+    TracoClima clima;
+    if (arqClima) {
+        if (!climaCsv(arqClima, clima)) { fprintf(stderr, "clima inválido: %s\n", arqClima); return 1; }
+    } else {
+        clima = climaSintetico(cen.dias, cen.semente);
+    }
+
+    std::vector<Limiares> combos = montarGrade(grade);
+    if (combos.empty()) { fprintf(stderr, "grade vazia\n"); return 1; }
+    std::vector<Avaliacao> res(combos.size());
+
+    fprintf(stderr, "%zu combinações, %u dias, passo %u s, %u threads\n",
+            combos.size(), cen.dias, cen.passo, threads);
+    auto t0 = std::chrono::steady_clock::now();
+
+    PoolRoubo pool(threads);
+    pool.distribuir(combos.size(), 8);
+    pool.executar([&](const Bloco& b) {
+        for (size_t i = b.ini; i < b.fim; i++) {
+            ResultadoSim r = simular(combos[i], planta, clima, cen);
+            res[i] = { combos[i], r.trocasLamp + r.trocasMot,
+                       (r.segForaTemp + r.segForaUmid) / 3600.0f, r.energiaWh / 1000 };
+        }
+    });
+
+    double seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "%.2f s (%.0f simulações/s, %u roubos)\n\n",
+            seg, combos.size() / seg, pool.roubos.load());
+
+    if (arqCsv) {
+        FILE* f = fopen(arqCsv, "w");
+        if (!f) { fprintf(stderr, "não abriu %s\n", arqCsv); return 1; }
+        fprintf(f, "tempLigar,tempDeslig,umidLigar,umidDeslig,luzLigar,luzDeslig,trocas,foraH,energiaKwh\n");
+        for (const Avaliacao& a : res)
+            fprintf(f, "%.1f,%.1f,%.1f,%.1f,%d,%d,%u,%.2f,%.3f\n",
+                    a.cfg.tempLigar, a.cfg.tempDeslig, a.cfg.umidLigar, a.cfg.umidDeslig,
+                    a.cfg.luzLigar, a.cfg.luzDeslig, a.trocas, a.foraH, a.energiaKwh);
+        fclose(f);
+    }
+
+    std::vector<Avaliacao> f = fronteira(res);
+    printf("Fronteira de Pareto – %zu de %zu combinações\n\n", f.size(), res.size());
+    printf("%-28s %8s %9s %10s\n", "limiares (T/U/Luz)", "trocas", "fora(h)", "energia");
+
+    // sugestão: ponto da fronteira com menor soma dos objetivos normalizados
+    float maxT = 1, maxF = 1e-6f, maxE = 1e-6f;
+    for (const Avaliacao& a : f) {
+        maxT = std::max(maxT, float(a.trocas)); maxF = std::max(maxF, a.foraH); maxE = std::max(maxE, a.energiaKwh);
+    }
+    const Avaliacao* melhor = &f[0];
+    float melhorNota = 1e9f;
+    for (const Avaliacao& a : f) {
+        char rotulo[40];
+        snprintf(rotulo, sizeof(rotulo), "%.1f/%.1f %.0f/%.0f %d/%d", a.cfg.tempLigar, a.cfg.tempDeslig,
+                 a.cfg.umidLigar, a.cfg.umidDeslig, a.cfg.luzLigar, a.cfg.luzDeslig);
+        printf("%-28s %8u %9.1f %7.2fkWh\n", rotulo, a.trocas, a.foraH, a.energiaKwh);
+        float nota = a.trocas / maxT + a.foraH / maxF + a.energiaKwh / maxE;
+        if (nota < melhorNota) { melhorNota = nota; melhor = &a; }
+    }
+
+    printf("\nEquilíbrio sugerido:\n"
+           "curl -X POST \"http://192.168.4.1/api/config?tempLigar=%.1f&tempDeslig=%.1f"
+           "&umidLigar=%.1f&umidDeslig=%.1f&luzLigar=%d&luzDeslig=%d\"\n",
+           melhor->cfg.tempLigar, melhor->cfg.tempDeslig, melhor->cfg.umidLigar,
+           melhor->cfg.umidDeslig, melhor->cfg.luzLigar, melhor->cfg.luzDeslig);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""
+Gera pagina_gz.h a partir de web/index.html.
+
+O dashboard é comprimido com gzip (nível 9, mtime fixo para que a saída
+seja reprodutível) e gravado como array PROGMEM, junto com um ETag
+derivado do hash do HTML original. O firmware envia os bytes como estão,
+com 'Content-Encoding: gzip', e responde 304 quando o navegador já tem
+a mesma versão.
+
+Rode sempre que editar web/index.html:
+
+    python3 tools/gerar_pagina.py
+"""
+import gzip
+import hashlib
+import pathlib
+
+RAIZ    = pathlib.Path(__file__).resolve().parent.parent
+ENTRADA = RAIZ / "web" / "index.html"
+SAIDA   = RAIZ / "pagina_gz.h"
+
+
+def main():
+    html = ENTRADA.read_bytes()
+    gz   = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(html).hexdigest()[:16]
+
+    linhas = []
+    for i in range(0, len(gz), 16):
+        linhas.append("    " + ",".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+
+    SAIDA.write_text(
+        "// Gerado por tools/gerar_pagina.py a partir de web/index.html – NÃO EDITE.\n"
+        "// Original: %d bytes | gzip: %d bytes\n"
+        "#pragma once\n"
+        "#include <Arduino.h>\n"
+        "\n"
+        "#define PAGINA_ETAG \"\\\"%s\\\"\"\n"
+        "\n"
+        "const size_t  PAGINA_GZ_TAM = %d;\n"
+        "const uint8_t PAGINA_GZ[] PROGMEM = {\n"
+        "%s\n"
+        "};\n" % (len(html), len(gz), etag, len(gz), "\n".join(linhas)),
+        encoding="utf-8",
+    )
+    print("%s: %d -> %d bytes (%.1fx), ETag %s"
+          % (SAIDA.name, len(html), len(gz), len(html) / len(gz), etag))
+
+
+if __name__ == "__main__":
+    main()
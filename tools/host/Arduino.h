@@ -0,0 +1,115 @@
+// ══════════════════════════════════════════════════════════
+//  Arduino-ESP32 para Linux – só o que main.c usa
+//  Relógio real (steady_clock), Serial em linhas, String sobre
+//  std::string. Ver tools/host/host.cpp.
+// ══════════════════════════════════════════════════════════
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string>
+#include <algorithm>
+
+#define HIGH          1
+#define LOW           0
+#define INPUT         0
+#define OUTPUT        1
+#define INPUT_PULLUP  2
+#define PROGMEM
+#define PGM_P         const char*
+#define memcpy_P      memcpy
+#define F(x)          x
+#define IRAM_ATTR
+
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+#define constrain(v, lo, hi) ((v) < (lo) ? (lo) : ((v) > (hi) ? (hi) : (v)))
+long map(long x, long deEm, long deAte, long paraEm, long paraAte);
+
+class String {
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& c) : s(c) {}
+    String(char c) : s(1, c) {}
+    String(int v)           : s(std::to_string(v)) {}
+    String(unsigned v)      : s(std::to_string(v)) {}
+    String(long v)          : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+    String(double v, int casas = 2);
+
+    unsigned    length() const { return s.size(); }
+    const char* c_str()  const { return s.c_str(); }
+    long        toInt()  const { return atol(s.c_str()); }
+    float       toFloat() const { return atof(s.c_str()); }
+    bool        reserve(unsigned n) { s.reserve(n); return true; }
+    String      substring(unsigned de, unsigned ate) const { return s.substr(de, ate - de); }
+    char        operator[](unsigned i) const { return s[i]; }
+
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o)   { s += o;   return *this; }
+    String& operator+=(char c)          { s += c;   return *this; }
+    friend String operator+(const String& a, const String& b) { return a.s + b.s; }
+    friend String operator+(const char* a, const String& b)   { return a + b.s; }
+    friend String operator+(const String& a, const char* b)   { return a.s + b; }
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator==(const char* o)   const { return s == o; }
+    bool operator!=(const char* o)   const { return s != o; }
+
+    std::string s;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) { return write(&c, 1); }
+    virtual size_t write(const uint8_t* p, size_t n) = 0;
+    size_t write(const char* p, size_t n) { return write((const uint8_t*)p, n); }
+
+    size_t print(const String& v) { return write(v.c_str(), v.length()); }
+    size_t print(const char* v)   { return write(v, strlen(v)); }
+    size_t print(char v)          { return write((uint8_t)v); }
+    size_t print(int v, int base = 10)           { return print((long)v, base); }
+    size_t print(unsigned v, int base = 10)      { return print((unsigned long)v, base); }
+    size_t print(long v, int base = 10);
+    size_t print(unsigned long v, int base = 10);
+    size_t print(double v, int casas = 2)        { return print(String(v, casas)); }
+
+    template <typename T> size_t println(T v)             { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(T v, int formato) { size_t n = print(v, formato); return n + println(); }
+    size_t println() { return write("\r\n", 2); }
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/** Serial do host: junta bytes em linhas e entrega a hostSerialLinha (padrão: stdout) */
+class HardwareSerial : public Print {
+public:
+    void   begin(unsigned long) {}
+    size_t write(const uint8_t* p, size_t n) override;
+    using Print::write;
+};
+extern HardwareSerial Serial;
+extern void (*hostSerialLinha)(const char* linha);   // chamada com a linha sem "\r\n"
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned us);
+
+void pinMode(uint8_t, uint8_t);
+void digitalWrite(uint8_t, uint8_t);
+int  digitalRead(uint8_t);
+
+bool     setCpuFrequencyMhz(uint32_t mhz);
+uint32_t getCpuFrequencyMhz();
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
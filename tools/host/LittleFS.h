@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+
+/** Arquivo ou diretório no disco do PC, dentro da raiz de LittleFS */
+class File {
+public:
+    File() {}
+    File(FILE* f, const std::string& nome);
+    File(const std::string& dir, std::vector<std::string> nomes);
+
+    operator bool() const { return arq || ehDir; }
+    size_t      write(const uint8_t* p, size_t n);
+    size_t      read(uint8_t* p, size_t n);
+    bool        seek(uint32_t pos);          // sempre a partir do início (SeekSet)
+    size_t      size();
+    void        close() { arq.reset(); ehDir = false; }
+    const char* name() const { return nome.c_str(); }
+    bool        isDirectory() const { return ehDir; }
+    File        openNextFile();
+
+private:
+    std::shared_ptr<FILE>    arq;
+    std::string              nome;
+    bool                     ehDir = false;
+    std::vector<std::string> filhos;   // só diretório
+    size_t                   proximo = 0;
+};
+
+/**
+ * LittleFS mapeado num diretório: ESTUFA_FS, ou ./littlefs_host. Os
+ * caminhos do firmware ("/log/00000001.bin") ficam abaixo dele.
+ */
+class LittleFSFS {
+public:
+    bool begin(bool formatarSeFalhar = false);
+    File open(const char* caminho, const char* modo = "r");
+    bool exists(const char* caminho);
+    bool mkdir(const char* caminho);
+    bool remove(const char* caminho);
+
+private:
+    std::string real(const char* caminho) const { return raiz + caminho; }
+    std::string raiz;
+};
+extern LittleFSFS LittleFS;
@@ -0,0 +1,60 @@
+#pragma once
+#include <Arduino.h>
+#include <WiFi.h>
+#include <map>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST };
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+/**
+ * WebServer síncrono do core, sobre TCP em 127.0.0.1. A porta vem de
+ * ESTUFA_PORTA (0 = escolhida pelo sistema, ver porta()); sem a variável,
+ * a do firmware + 8000. Cada handleClient() atende no máximo uma conexão
+ * e fecha ao fim (Connection: close), como o original.
+ */
+class WebServer {
+public:
+    typedef void (*THandlerFunction)();
+
+    explicit WebServer(int porta) : portaPedida(porta) {}
+
+    void begin();
+    void handleClient();
+    void on(const char* uri, HTTPMethod m, THandlerFunction f) { rotas.push_back({ uri, m, f }); }
+    void onNotFound(THandlerFunction f) { naoAchou = f; }
+    void collectHeaders(const char** nomes, size_t n) { coletar.assign(nomes, nomes + n); }
+
+    bool   hasArg(const String& nome) const { return args.count(nome.s) > 0; }
+    String arg(const String& nome) const;
+    String header(const String& nome) const;
+    String uri() const { return caminho; }
+    WiFiClient client() { return atual; }
+
+    void setContentLength(size_t n) { tamConteudo = n; }
+    void sendHeader(const String& nome, const String& valor, bool primeiro = false);
+    void send(int codigo, const char* tipo = nullptr, const String& corpo = String());
+    void send_P(int codigo, PGM_P tipo, PGM_P corpo, size_t n);
+    void sendContent(const String& s) { sendContent(s.c_str(), s.length()); }
+    void sendContent(const char* p, size_t n);
+
+    uint16_t porta() const { return portaReal; }   // só no host
+
+private:
+    struct Rota { String uri; HTTPMethod metodo; THandlerFunction f; };
+    void cabecalho(int codigo, const char* tipo, size_t n);
+
+    int                 portaPedida, escuta = -1;
+    uint16_t            portaReal = 0;
+    std::vector<Rota>   rotas;
+    THandlerFunction    naoAchou = nullptr;
+    std::vector<String> coletar;
+
+    WiFiClient                         atual;
+    HTTPMethod                         metodo = HTTP_GET;
+    String                             caminho;
+    std::map<std::string, std::string> args, cabecalhos;
+    std::string                        extras;      // sendHeader() acumulado
+    size_t                             tamConteudo = 0;
+    bool                               emPedacos   = false;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <Arduino.h>
+#include <memory>
+
+#define WIFI_AP 2
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : o{ a, b, c, d } {}
+    uint8_t operator[](int i) const { return o[i]; }
+    String  toString() const;
+private:
+    uint8_t o[4];
+};
+
+/**
+ * Cliente TCP sobre um socket de verdade. Cópias dividem o socket, que
+ * só fecha quando a última sai de cena (como no core 2.x); stop() solta
+ * apenas esta cópia.
+ */
+class WiFiClient : public Print {
+public:
+    WiFiClient() {}
+    explicit WiFiClient(int fd);
+
+    int     fd() const;
+    uint8_t connected();
+    operator bool() { return connected(); }
+    void    stop() { sock.reset(); }
+    void    setNoDelay(bool ligado);
+    int     available();
+    int     read(uint8_t* p, size_t n);
+    size_t  write(const uint8_t* p, size_t n) override;   // bloqueante, como o original
+    using Print::write;
+
+private:
+    struct Socket;
+    std::shared_ptr<Socket> sock;
+};
+
+class WiFiClass {
+public:
+    void      mode(int) {}
+    bool      softAP(const char*, const char* = nullptr) { return true; }
+    IPAddress softAPIP() { return IPAddress(127, 0, 0, 1); }
+    uint8_t   softAPgetStationNum() { return estacoes; }
+
+    uint8_t estacoes = 0;   // host: 1 depois da 1ª conexão aceita – na placa, quem fala HTTP está associado
+};
+extern WiFiClass WiFi;
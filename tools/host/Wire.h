@@ -0,0 +1,26 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#define I2C_BUFFER_LENGTH 128   // como no core: write() além disso é descartado
+
+/** I2C que conta e entrega cada transação a hostI2cTransacao (se houver) */
+class TwoWire {
+public:
+    bool    begin(int sda = -1, int scl = -1, uint32_t freq = 0);
+    void    beginTransmission(uint8_t endereco);
+    size_t  write(uint8_t b) { return write(&b, 1); }
+    size_t  write(const uint8_t* p, size_t n);
+    uint8_t endTransmission(bool parar = true);
+
+    uint32_t transacoes = 0;
+    uint32_t bytes      = 0;   // inclui o byte de endereço de cada transação
+
+private:
+    uint8_t endereco = 0;
+    uint8_t buf[I2C_BUFFER_LENGTH];
+    size_t  tam = 0;
+};
+extern TwoWire Wire;
+
+extern void (*hostI2cTransacao)(uint8_t endereco, const uint8_t* p, size_t n);   // no endTransmission()
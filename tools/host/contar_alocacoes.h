@@ -0,0 +1,54 @@
+/*
+ * Conta as alocações do processo inteiro: malloc, calloc, realloc e,
+ * através deles, new/delete e std::string. Para testes no host que
+ * exigem "nenhuma alocação" num trecho do firmware.
+ *
+ * Incluir em UM único .cpp do executável (define malloc e companhia).
+ *
+ *     ContagemAlocacoes a = alocacoesAgora();
+ *     ... trecho ...
+ *     ContagemAlocacoes d = alocacoesDesde(a);   // d.chamadas, d.bytes
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void  __libc_free(void*);
+}
+
+struct ContagemAlocacoes { size_t chamadas, bytes; };
+
+static std::atomic<size_t> alocChamadas{0}, alocBytes{0};
+
+extern "C" {
+void* malloc(size_t n) {
+    alocChamadas.fetch_add(1, std::memory_order_relaxed);
+    alocBytes.fetch_add(n, std::memory_order_relaxed);
+    return __libc_malloc(n);
+}
+void* calloc(size_t k, size_t n) {
+    alocChamadas.fetch_add(1, std::memory_order_relaxed);
+    alocBytes.fetch_add(k * n, std::memory_order_relaxed);
+    return __libc_calloc(k, n);
+}
+void* realloc(void* p, size_t n) {
+    alocChamadas.fetch_add(1, std::memory_order_relaxed);
+    alocBytes.fetch_add(n, std::memory_order_relaxed);
+    return __libc_realloc(p, n);
+}
+void free(void* p) { __libc_free(p); }
+}
+
+inline ContagemAlocacoes alocacoesAgora() {
+    return { alocChamadas.load(std::memory_order_relaxed), alocBytes.load(std::memory_order_relaxed) };
+}
+
+inline ContagemAlocacoes alocacoesDesde(const ContagemAlocacoes& a) {
+    ContagemAlocacoes b = alocacoesAgora();
+    return { b.chamadas - a.chamadas, b.bytes - a.bytes };
+}
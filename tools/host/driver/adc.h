@@ -0,0 +1,8 @@
+#pragma once
+#include "gpio.h"
+typedef enum { ADC_UNIT_1 = 1 } adc_unit_t;
+typedef enum { ADC1_CHANNEL_6 = 6 } adc1_channel_t;
+typedef enum { ADC_ATTEN_DB_0, ADC_ATTEN_DB_11 = 3 } adc_atten_t;
+typedef enum { ADC_WIDTH_BIT_12 = 3 } adc_bits_width_t;
+esp_err_t adc1_config_channel_atten(adc1_channel_t, adc_atten_t);
+esp_err_t adc1_config_width(adc_bits_width_t);
@@ -0,0 +1,16 @@
+// Drivers do ESP-IDF: só declarações. O host roda com HAL_SIMULADA = 1
+// e nada daqui é chamado (nem ligado).
+#pragma once
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK   0
+#define ESP_FAIL -1
+
+typedef int gpio_num_t;
+typedef enum { GPIO_MODE_INPUT, GPIO_MODE_OUTPUT, GPIO_MODE_INPUT_OUTPUT_OD, GPIO_MODE_INPUT_OUTPUT } gpio_mode_t;
+typedef enum { GPIO_PULLUP_ONLY, GPIO_FLOATING } gpio_pull_mode_t;
+esp_err_t gpio_set_direction(gpio_num_t, gpio_mode_t);
+esp_err_t gpio_set_level(gpio_num_t, uint32_t);
+esp_err_t gpio_set_pull_mode(gpio_num_t, gpio_pull_mode_t);
+int       gpio_get_level(gpio_num_t);
@@ -0,0 +1,18 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "gpio.h"
+#include "freertos/ringbuf.h"
+typedef int rmt_channel_t;
+#define RMT_CHANNEL_0 0
+#define RMT_CHANNEL_4 4
+typedef struct { union { struct { uint32_t duration0:15, level0:1, duration1:15, level1:1; }; uint32_t val; }; } rmt_item32_t;
+typedef enum { RMT_MODE_TX, RMT_MODE_RX } rmt_mode_t;
+typedef struct { uint16_t idle_threshold; uint8_t filter_ticks_thresh; bool filter_en; } rmt_rx_config_t;
+typedef struct { rmt_mode_t rmt_mode; rmt_channel_t channel; gpio_num_t gpio_num; uint8_t clk_div; uint8_t mem_block_num; uint32_t flags; rmt_rx_config_t rx_config; } rmt_config_t;
+#define RMT_DEFAULT_CONFIG_RX(g, c) { RMT_MODE_RX, c, g, 80, 1, 0, { 12000, 100, true } }
+esp_err_t rmt_config(const rmt_config_t*);
+esp_err_t rmt_driver_install(rmt_channel_t, size_t, int);
+esp_err_t rmt_get_ringbuf_handle(rmt_channel_t, RingbufHandle_t*);
+esp_err_t rmt_rx_start(rmt_channel_t, bool);
+esp_err_t rmt_rx_stop(rmt_channel_t);
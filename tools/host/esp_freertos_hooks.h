@@ -0,0 +1,9 @@
+#pragma once
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+
+// Ganchos aceitos e nunca chamados: no host /api/energia mostra tudo como ativo
+typedef bool (*esp_freertos_idle_cb_t)(void);
+typedef void (*esp_freertos_tick_cb_t)(void);
+esp_err_t esp_register_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t, UBaseType_t);
+esp_err_t esp_register_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t, UBaseType_t);
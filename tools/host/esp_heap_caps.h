@@ -0,0 +1,13 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT      (1 << 2)
+#define MALLOC_CAP_INTERNAL  (1 << 11)
+
+// heap interno de um ESP32 com o AP no ar; o host finge esses números
+// para que alocarMemoria() tome as mesmas decisões da placa
+extern size_t hostHeapLivre;
+void*  heap_caps_calloc(size_t n, size_t tam, uint32_t caps);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
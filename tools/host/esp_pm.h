@@ -0,0 +1,7 @@
+#pragma once
+#include "driver/gpio.h"
+
+// Sem gerência de energia no host: esp_pm_configure recusa e o firmware fica em "desligado"
+#define ESP_ERR_NOT_SUPPORTED 0x106
+typedef struct { int max_freq_mhz; int min_freq_mhz; bool light_sleep_enable; } esp_pm_config_esp32_t;
+esp_err_t esp_pm_configure(const void* cfg);
@@ -0,0 +1,24 @@
+// FreeRTOS do ESP-IDF emulado com std::thread – ver tools/host/host.cpp
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+typedef uint32_t TickType_t;   // 1 tick = 1 ms (CONFIG_FREERTOS_HZ = 1000)
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              pdTRUE
+#define portMAX_DELAY       0xFFFFFFFFu
+#define portTICK_PERIOD_MS  1
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+#define tskIDLE_PRIORITY    0
+
+/** Spinlock; seções críticas não aninham o mesmo mux (igual ao firmware) */
+struct portMUX_TYPE { std::atomic<int> trava; };
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+void portENTER_CRITICAL(portMUX_TYPE* m);
+void portEXIT_CRITICAL(portMUX_TYPE* m);
+#define portENTER_CRITICAL_ISR(m) portENTER_CRITICAL(m)
+#define portEXIT_CRITICAL_ISR(m)  portEXIT_CRITICAL(m)
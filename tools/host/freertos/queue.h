@@ -0,0 +1,10 @@
+#pragma once
+#include "FreeRTOS.h"
+
+struct FilaHost;
+typedef FilaHost* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t tamanho, UBaseType_t tamItem);
+BaseType_t    xQueueSend(QueueHandle_t q, const void* item, TickType_t espera);
+BaseType_t    xQueueReceive(QueueHandle_t q, void* item, TickType_t espera);
+UBaseType_t   uxQueueMessagesWaiting(QueueHandle_t q);
@@ -0,0 +1,8 @@
+#pragma once
+#include <stddef.h>
+#include "FreeRTOS.h"
+
+// só o driver RMT do DHT22 usa; o host roda com HAL_SIMULADA = 1
+typedef void* RingbufHandle_t;
+void* xRingbufferReceive(RingbufHandle_t, size_t*, TickType_t);
+void  vRingbufferReturnItem(RingbufHandle_t, void*);
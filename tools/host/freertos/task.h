@@ -0,0 +1,16 @@
+#pragma once
+#include "FreeRTOS.h"
+
+struct TarefaHost;
+typedef TarefaHost* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t   xTaskCreatePinnedToCore(TaskFunction_t f, const char* nome, uint32_t pilha, void* arg,
+                                     UBaseType_t prioridade, TaskHandle_t* h, BaseType_t nucleo);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+void         vTaskDelete(TaskHandle_t h);   // só nullptr (a própria tarefa)
+void         vTaskDelay(TickType_t ticks);
+TickType_t   xTaskGetTickCount();
+BaseType_t   xPortGetCoreID();
+BaseType_t   xTaskNotifyGive(TaskHandle_t h);
+uint32_t     ulTaskNotifyTake(BaseType_t limpar, TickType_t espera);
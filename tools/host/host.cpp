@@ -0,0 +1,559 @@
+// ══════════════════════════════════════════════════════════
+//  Implementação para Linux do pedaço do Arduino-ESP32 e do
+//  FreeRTOS que main.c usa. Tarefas viram std::thread, filas e
+//  notificações viram mutex + condition_variable, WebServer e
+//  WiFiClient usam sockets TCP de verdade e LittleFS um diretório.
+//  Não há escalonador por prioridade nem núcleos: o que se mede
+//  aqui é a lógica, não o tempo da placa.
+// ══════════════════════════════════════════════════════════
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WebServer.h>
+#include <LittleFS.h>
+#include <Wire.h>
+#include <esp_timer.h>
+#include <esp_pm.h>
+#include <esp_freertos_hooks.h>
+#include <esp_heap_caps.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ──────────────────────────────────────────────────────────
+//  Relógio
+// ──────────────────────────────────────────────────────────
+static const auto INICIO = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - INICIO).count();
+}
+
+unsigned long millis() { return (unsigned long)(esp_timer_get_time() / 1000); }
+unsigned long micros() { return (unsigned long)esp_timer_get_time(); }
+void delay(unsigned long ms)         { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(unsigned us)  { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+
+long map(long x, long deEm, long deAte, long paraEm, long paraAte) {
+    return (x - deEm) * (paraAte - paraEm) / (deAte - deEm) + paraEm;
+}
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int  digitalRead(uint8_t) { return LOW; }
+
+static uint32_t cpuMhz = 240;
+bool     setCpuFrequencyMhz(uint32_t mhz) { cpuMhz = mhz; return true; }
+uint32_t getCpuFrequencyMhz()             { return cpuMhz; }
+
+esp_err_t esp_pm_configure(const void*) { return ESP_ERR_NOT_SUPPORTED; }
+esp_err_t esp_register_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t, UBaseType_t) { return ESP_OK; }
+esp_err_t esp_register_freertos_tick_hook_for_cpu(esp_freertos_tick_cb_t, UBaseType_t) { return ESP_OK; }
+
+// ──────────────────────────────────────────────────────────
+//  Heap interno fingido (ver esp_heap_caps.h)
+// ──────────────────────────────────────────────────────────
+size_t hostHeapLivre = 180 * 1024;   // ESP32 com o softAP no ar e sem os anéis
+
+void* heap_caps_calloc(size_t n, size_t tam, uint32_t) {
+    if (n * tam > hostHeapLivre) return nullptr;
+    hostHeapLivre -= n * tam;
+    return calloc(n, tam);
+}
+size_t heap_caps_get_free_size(uint32_t)          { return hostHeapLivre; }
+size_t heap_caps_get_largest_free_block(uint32_t) { return hostHeapLivre; }
+
+// ──────────────────────────────────────────────────────────
+//  String e Print
+// ──────────────────────────────────────────────────────────
+String::String(double v, int casas) {
+    char b[40];
+    snprintf(b, sizeof(b), "%.*f", casas, v);
+    s = b;
+}
+
+size_t Print::print(long v, int base) {
+    char b[24];
+    if (base == 16) snprintf(b, sizeof(b), "%lX", (unsigned long)v);
+    else            snprintf(b, sizeof(b), "%ld", v);
+    return print(b);
+}
+
+size_t Print::print(unsigned long v, int base) {
+    char b[24];
+    snprintf(b, sizeof(b), base == 16 ? "%lX" : "%lu", v);
+    return print(b);
+}
+
+size_t Print::printf(const char* fmt, ...) {
+    char    b[512];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(b, sizeof(b), fmt, ap);
+    va_end(ap);
+    if (n < 0) return 0;
+    return write(b, std::min((size_t)n, sizeof(b) - 1));
+}
+
+HardwareSerial Serial;
+void (*hostSerialLinha)(const char* linha) = nullptr;
+
+// uma linha em montagem por thread: tarefas imprimem ao mesmo tempo
+static thread_local std::string serialLinha;
+static std::mutex               muxSerial;
+
+size_t HardwareSerial::write(const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        char c = (char)p[i];
+        if (c == '\r') continue;
+        if (c != '\n') { serialLinha += c; continue; }
+        std::lock_guard<std::mutex> g(muxSerial);
+        if (hostSerialLinha) hostSerialLinha(serialLinha.c_str());
+        else                 { fputs(serialLinha.c_str(), stdout); fputc('\n', stdout); fflush(stdout); }
+        serialLinha.clear();
+    }
+    return n;
+}
+
+// ──────────────────────────────────────────────────────────
+//  FreeRTOS
+// ──────────────────────────────────────────────────────────
+void portENTER_CRITICAL(portMUX_TYPE* m) {
+    int livre = 0;
+    while (!m->trava.compare_exchange_weak(livre, 1, std::memory_order_acquire)) {
+        livre = 0;
+        std::this_thread::yield();
+    }
+}
+void portEXIT_CRITICAL(portMUX_TYPE* m) { m->trava.store(0, std::memory_order_release); }
+
+struct TarefaHost {
+    const char*             nome;
+    int                     nucleo;
+    std::mutex              mux;
+    std::condition_variable cv;
+    uint32_t                notificacoes = 0;
+};
+
+struct FimTarefa {};   // vTaskDelete(nullptr) desenrola até o trampolim
+
+static thread_local TarefaHost* tarefaAtual = nullptr;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t f, const char* nome, uint32_t, void* arg,
+                                   UBaseType_t, TaskHandle_t* h, BaseType_t nucleo) {
+    TarefaHost* t = new TarefaHost;   // vive até o fim do processo (handles podem sobrar)
+    t->nome   = nome;
+    t->nucleo = nucleo;
+    if (h) *h = t;
+    std::thread([=] {
+        tarefaAtual = t;
+        try { f(arg); } catch (const FimTarefa&) {}
+    }).detach();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return tarefaAtual; }
+
+void vTaskDelete(TaskHandle_t h) {
+    if (h && h != tarefaAtual) { fprintf(stderr, "vTaskDelete de outra tarefa não é suportado\n"); abort(); }
+    throw FimTarefa{};
+}
+
+void       vTaskDelay(TickType_t ticks) { delay(ticks); }
+TickType_t xTaskGetTickCount()          { return (TickType_t)millis(); }
+BaseType_t xPortGetCoreID()             { return tarefaAtual ? tarefaAtual->nucleo : 1; }
+
+BaseType_t xTaskNotifyGive(TaskHandle_t h) {
+    {
+        std::lock_guard<std::mutex> g(h->mux);
+        h->notificacoes++;
+    }
+    h->cv.notify_one();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t limpar, TickType_t espera) {
+    TarefaHost* t = tarefaAtual;
+    std::unique_lock<std::mutex> g(t->mux);
+    auto tem = [t] { return t->notificacoes > 0; };
+    if (espera == portMAX_DELAY) t->cv.wait(g, tem);
+    else                         t->cv.wait_for(g, std::chrono::milliseconds(espera), tem);
+    uint32_t n = t->notificacoes;
+    if (n) t->notificacoes = limpar ? 0 : n - 1;
+    return n;
+}
+
+struct FilaHost {
+    size_t                            cap, tamItem;
+    std::deque<std::vector<uint8_t>>  itens;
+    std::mutex                        mux;
+    std::condition_variable           cv;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t tamanho, UBaseType_t tamItem) {
+    FilaHost* q = new FilaHost;
+    q->cap = tamanho;
+    q->tamItem = tamItem;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t espera) {
+    std::unique_lock<std::mutex> g(q->mux);
+    auto cabe = [q] { return q->itens.size() < q->cap; };
+    if (espera == portMAX_DELAY) q->cv.wait(g, cabe);
+    else if (!q->cv.wait_for(g, std::chrono::milliseconds(espera), cabe)) return pdFALSE;
+    const uint8_t* p = (const uint8_t*)item;
+    q->itens.emplace_back(p, p + q->tamItem);
+    g.unlock();
+    q->cv.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t espera) {
+    std::unique_lock<std::mutex> g(q->mux);
+    auto tem = [q] { return !q->itens.empty(); };
+    if (espera == portMAX_DELAY) q->cv.wait(g, tem);
+    else if (!q->cv.wait_for(g, std::chrono::milliseconds(espera), tem)) return pdFALSE;
+    memcpy(item, q->itens.front().data(), q->tamItem);
+    q->itens.pop_front();
+    g.unlock();
+    q->cv.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> g(q->mux);
+    return q->itens.size();
+}
+
+// ──────────────────────────────────────────────────────────
+//  I2C (só conta)
+// ──────────────────────────────────────────────────────────
+TwoWire Wire;
+
+void (*hostI2cTransacao)(uint8_t endereco, const uint8_t* p, size_t n) = nullptr;
+
+bool TwoWire::begin(int, int, uint32_t) { return true; }
+
+void TwoWire::beginTransmission(uint8_t e) {
+    endereco = e;
+    tam      = 0;
+}
+
+size_t TwoWire::write(const uint8_t* p, size_t n) {
+    n = std::min(n, sizeof(buf) - tam);
+    memcpy(buf + tam, p, n);
+    tam += n;
+    return n;
+}
+
+/** Conta só o que sai no barramento: endereço + bytes que couberam no buffer */
+uint8_t TwoWire::endTransmission(bool) {
+    transacoes++;
+    bytes += 1 + tam;
+    if (hostI2cTransacao) hostI2cTransacao(endereco, buf, tam);
+    tam = 0;
+    return 0;
+}
+
+// ──────────────────────────────────────────────────────────
+//  WiFi
+// ──────────────────────────────────────────────────────────
+WiFiClass WiFi;
+
+String IPAddress::toString() const {
+    char b[16];
+    snprintf(b, sizeof(b), "%u.%u.%u.%u", o[0], o[1], o[2], o[3]);
+    return b;
+}
+
+struct WiFiClient::Socket {
+    int fd;
+    ~Socket() { ::close(fd); }
+};
+
+WiFiClient::WiFiClient(int fd) : sock(new Socket{ fd }) {}
+
+int WiFiClient::fd() const { return sock ? sock->fd : -1; }
+
+uint8_t WiFiClient::connected() {
+    if (!sock) return 0;
+    char    c;
+    ssize_t r = recv(sock->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (r > 0) return 1;
+    if (r == 0) return 0;   // o outro lado fechou
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+void WiFiClient::setNoDelay(bool ligado) {
+    int v = ligado;
+    if (sock) setsockopt(sock->fd, IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v));
+}
+
+int WiFiClient::available() {
+    if (!sock) return 0;
+    char    b[256];
+    ssize_t r = recv(sock->fd, b, sizeof(b), MSG_PEEK | MSG_DONTWAIT);
+    return r > 0 ? (int)r : 0;
+}
+
+int WiFiClient::read(uint8_t* p, size_t n) {
+    if (!sock) return -1;
+    return (int)recv(sock->fd, p, n, 0);
+}
+
+size_t WiFiClient::write(const uint8_t* p, size_t n) {
+    size_t feito = 0;
+    while (sock && feito < n) {
+        ssize_t r = send(sock->fd, p + feito, n - feito, MSG_NOSIGNAL);
+        if (r <= 0) break;
+        feito += r;
+    }
+    return feito;
+}
+
+// ──────────────────────────────────────────────────────────
+//  WebServer
+// ──────────────────────────────────────────────────────────
+static std::string urlDecodificar(const std::string& s) {
+    std::string r;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '+') { r += ' '; continue; }
+        if (s[i] == '%' && i + 2 < s.size()) { r += (char)strtol(s.substr(i + 1, 2).c_str(), nullptr, 16); i += 2; continue; }
+        r += s[i];
+    }
+    return r;
+}
+
+static void lerArgs(const std::string& q, std::map<std::string, std::string>& args) {
+    size_t i = 0;
+    while (i < q.size()) {
+        size_t fim = q.find('&', i);
+        if (fim == std::string::npos) fim = q.size();
+        std::string par = q.substr(i, fim - i);
+        size_t      ig  = par.find('=');
+        if (!par.empty())
+            args[urlDecodificar(par.substr(0, ig))] = ig == std::string::npos ? "" : urlDecodificar(par.substr(ig + 1));
+        i = fim + 1;
+    }
+}
+
+void WebServer::begin() {
+    const char* env = getenv("ESTUFA_PORTA");
+    int porta = env ? atoi(env) : portaPedida + 8000;
+
+    escuta = socket(AF_INET, SOCK_STREAM, 0);
+    int um = 1;
+    setsockopt(escuta, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+    sockaddr_in a = {};
+    a.sin_family      = AF_INET;
+    a.sin_port        = htons(porta);
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(escuta, (sockaddr*)&a, sizeof(a)) < 0 || listen(escuta, 16) < 0) {
+        fprintf(stderr, "WebServer: porta %d indisponível: %s\n", porta, strerror(errno));
+        exit(1);
+    }
+    fcntl(escuta, F_SETFL, O_NONBLOCK);
+    socklen_t n = sizeof(a);
+    getsockname(escuta, (sockaddr*)&a, &n);
+    portaReal = ntohs(a.sin_port);
+}
+
+String WebServer::arg(const String& nome) const {
+    auto i = args.find(nome.s);
+    return i == args.end() ? String() : String(i->second);
+}
+
+String WebServer::header(const String& nome) const {
+    auto i = cabecalhos.find(nome.s);
+    return i == cabecalhos.end() ? String() : String(i->second);
+}
+
+void WebServer::handleClient() {
+    if (escuta < 0) return;
+    int fd = accept(escuta, nullptr, nullptr);
+    if (fd < 0) return;
+    WiFi.estacoes = 1;
+    // buffer de envio do lwIP da placa (TCP_SND_BUF = 5744); o Linux cresceria
+    // sozinho e um leitor lento nunca faria o servidor esperar
+    int tam = 5744 / 2;   // o Linux dobra o valor pedido
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &tam, sizeof(tam));
+
+    // pedido inteiro com até 1 s de paciência (o original espera 5 s pelo cabeçalho)
+    std::string pedido;
+    size_t      fimCab = std::string::npos, tamCorpo = 0;
+    pollfd      p      = { fd, POLLIN, 0 };
+    while (poll(&p, 1, 1000) > 0) {
+        char    b[1024];
+        ssize_t r = recv(fd, b, sizeof(b), 0);
+        if (r <= 0) break;
+        pedido.append(b, r);
+        if (fimCab == std::string::npos && (fimCab = pedido.find("\r\n\r\n")) != std::string::npos) {
+            size_t cl = pedido.find("Content-Length:");
+            if (cl != std::string::npos && cl < fimCab) tamCorpo = strtoul(pedido.c_str() + cl + 15, nullptr, 10);
+        }
+        if (fimCab != std::string::npos && pedido.size() >= fimCab + 4 + tamCorpo) break;
+    }
+    if (fimCab == std::string::npos) { ::close(fd); return; }
+
+    atual = WiFiClient(fd);
+    args.clear();
+    cabecalhos.clear();
+    extras.clear();
+    tamConteudo = 0;
+    emPedacos   = false;
+
+    std::string linha = pedido.substr(0, pedido.find("\r\n"));
+    size_t      e1 = linha.find(' '), e2 = linha.find(' ', e1 + 1);
+    std::string alvo = linha.substr(e1 + 1, e2 - e1 - 1);
+    metodo = linha.compare(0, 4, "POST") == 0 ? HTTP_POST : HTTP_GET;
+    size_t q = alvo.find('?');
+    caminho = alvo.substr(0, q);
+    if (q != std::string::npos) lerArgs(alvo.substr(q + 1), args);
+
+    for (size_t i = pedido.find("\r\n") + 2; i < fimCab; ) {
+        size_t      fim = pedido.find("\r\n", i);
+        std::string h   = pedido.substr(i, fim - i);
+        size_t      dp  = h.find(':');
+        for (const String& c : coletar)
+            if (dp != std::string::npos && strncasecmp(h.c_str(), c.c_str(), dp) == 0 && c.length() == dp)
+                cabecalhos[c.s] = h.substr(h.find_first_not_of(' ', dp + 1));
+        i = fim + 2;
+    }
+    std::string corpo = pedido.substr(fimCab + 4, tamCorpo);
+    if (metodo == HTTP_POST) {
+        if (pedido.find("application/x-www-form-urlencoded") < fimCab) lerArgs(corpo, args);
+        else if (!corpo.empty())                                       args["plain"] = corpo;
+    }
+
+    THandlerFunction f = naoAchou;
+    for (const Rota& r : rotas)
+        if (r.uri.s == caminho.s && (r.metodo == HTTP_ANY || r.metodo == metodo)) { f = r.f; break; }
+    if (f) f();
+    else   send(404, "text/plain", "Not Found");
+
+    atual = WiFiClient();   // quem guardou uma cópia (SSE) mantém o socket aberto
+}
+
+void WebServer::sendHeader(const String& nome, const String& valor, bool primeiro) {
+    std::string h = nome.s + ": " + valor.s + "\r\n";
+    extras = primeiro ? h + extras : extras + h;
+}
+
+static const char* motivo(int codigo) {
+    switch (codigo) {
+        case 200: return "OK";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  return "";
+    }
+}
+
+void WebServer::cabecalho(int codigo, const char* tipo, size_t n) {
+    char b[160];
+    int  k = snprintf(b, sizeof(b), "HTTP/1.1 %d %s\r\n", codigo, motivo(codigo));
+    std::string h(b, k);
+    if (tipo && *tipo) h += std::string("Content-Type: ") + tipo + "\r\n";
+    if (tamConteudo == CONTENT_LENGTH_UNKNOWN) { h += "Transfer-Encoding: chunked\r\n"; emPedacos = true; }
+    else h += "Content-Length: " + std::to_string(n) + "\r\n";
+    h += extras;
+    if (extras.find("Connection:") == std::string::npos) h += "Connection: close\r\n";
+    h += "\r\n";
+    extras.clear();
+    atual.write((const uint8_t*)h.data(), h.size());
+}
+
+void WebServer::send(int codigo, const char* tipo, const String& corpo) {
+    cabecalho(codigo, tipo, corpo.length());
+    if (emPedacos) { if (corpo.length()) sendContent(corpo); }
+    else           atual.write((const uint8_t*)corpo.c_str(), corpo.length());
+}
+
+void WebServer::send_P(int codigo, PGM_P tipo, PGM_P corpo, size_t n) {
+    cabecalho(codigo, tipo, n);
+    atual.write((const uint8_t*)corpo, n);
+}
+
+void WebServer::sendContent(const char* p, size_t n) {
+    if (!emPedacos) { atual.write((const uint8_t*)p, n); return; }
+    char b[16];
+    int  k = snprintf(b, sizeof(b), "%zX\r\n", n);
+    atual.write((const uint8_t*)b, k);
+    if (n) atual.write((const uint8_t*)p, n);
+    atual.write((const uint8_t*)"\r\n", 2);
+    if (!n) emPedacos = false;
+}
+
+// ──────────────────────────────────────────────────────────
+//  LittleFS
+// ──────────────────────────────────────────────────────────
+LittleFSFS LittleFS;
+
+File::File(FILE* f, const std::string& n) : arq(f, fclose), nome(n) {}
+File::File(const std::string& dir, std::vector<std::string> nomes)
+    : nome(dir), ehDir(true), filhos(std::move(nomes)) {}
+
+size_t File::write(const uint8_t* p, size_t n) { return arq ? fwrite(p, 1, n, arq.get()) : 0; }
+size_t File::read(uint8_t* p, size_t n)        { return arq ? fread(p, 1, n, arq.get()) : 0; }
+bool   File::seek(uint32_t pos)                { return arq && fseek(arq.get(), pos, SEEK_SET) == 0; }
+
+size_t File::size() {
+    if (!arq) return 0;
+    struct stat st;
+    fflush(arq.get());
+    return fstat(fileno(arq.get()), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+File File::openNextFile() {
+    if (!ehDir || proximo >= filhos.size()) return File();
+    const std::string& n = filhos[proximo++];
+    FILE* f = fopen((nome + "/" + n).c_str(), "r");
+    return f ? File(f, n) : File();
+}
+
+bool LittleFSFS::begin(bool) {
+    const char* env = getenv("ESTUFA_FS");
+    raiz = env ? env : "littlefs_host";
+    ::mkdir(raiz.c_str(), 0755);
+    struct stat st;
+    return stat(raiz.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+File LittleFSFS::open(const char* caminho, const char* modo) {
+    std::string r = real(caminho);
+    struct stat st;
+    if (stat(r.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        std::vector<std::string> nomes;
+        if (DIR* d = opendir(r.c_str())) {
+            while (dirent* e = readdir(d))
+                if (e->d_name[0] != '.') nomes.push_back(e->d_name);
+            closedir(d);
+        }
+        return File(r, nomes);
+    }
+    FILE* f = fopen(r.c_str(), strcmp(modo, "r") == 0 ? "rb" : strcmp(modo, "a") == 0 ? "ab" : "wb");
+    const char* barra = strrchr(caminho, '/');
+    return f ? File(f, barra ? barra + 1 : caminho) : File();
+}
+
+bool LittleFSFS::exists(const char* caminho) { struct stat st; return stat(real(caminho).c_str(), &st) == 0; }
+bool LittleFSFS::mkdir(const char* caminho)  { return ::mkdir(real(caminho).c_str(), 0755) == 0; }
+bool LittleFSFS::remove(const char* caminho) { return ::remove(real(caminho).c_str()) == 0; }
@@ -0,0 +1,151 @@
+/*
+ * Firmware inteiro no PC: main.c com HAL_SIMULADA = 1 sobre o
+ * Arduino/FreeRTOS de tools/host, mais rápido que o tempo real.
+ *
+ * setup() e loop() rodam numa tarefa "loopTask" como na placa; os
+ * sensores seguem um traço roteirizado e cada troca de relé e cada
+ * escrita no LCD vira uma linha do registro. O servidor web sobe de
+ * verdade em 127.0.0.1 (a porta sai no começo do registro).
+ *
+ * Compilar: ver CMakeLists.txt (alvo simular_firmware).
+ *
+ * Uso:
+ *
+ *     ./simular_firmware [--traco arquivo.csv] [--horas N] [--registro saida.txt]
+ *                        [--espera hh:mm,lampada=0|1,motor=0|1] ... [-v]
+ *
+ * O traço é um CSV "segundo,temp,umid,luz" (luz em %, primeiro ponto no
+ * segundo 0) repetido a cada período do último ponto; sem --traco vale o
+ * dia típico embutido em main.c. Cada --espera confere o estado dos relés
+ * no instante simulado dado; qualquer divergência dá código de saída 1.
+ * -v repete no terminal todo o Monitor Serie do firmware.
+ */
+#include "../../main.c"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Espera { uint32_t t; int lampada, motor; bool conferida; };
+
+static FILE*               registro = stdout;
+static bool                verboso  = false;
+static std::vector<PontoTraco> tracoLido;
+static uint32_t            trocas[2], quadrosLcd;
+
+static void uso() {
+    fprintf(stderr,
+        "uso: simular_firmware [--traco arq.csv] [--horas N] [--registro saida.txt]\n"
+        "                      [--espera hh:mm,lampada=0|1,motor=0|1] ... [-v]\n");
+    exit(2);
+}
+
+/** Linha do Monitor Serie: relés e LCD vão para o registro, o resto só com -v */
+static void linhaSerial(const char* l) {
+    unsigned long t;
+    char          canal[16], estado[8];
+    unsigned      lin;
+    if (sscanf(l, "[SIM] t=%lus %15s -> %7s", &t, canal, estado) == 3) {
+        trocas[strcmp(canal, "motor") == 0]++;
+        fprintf(registro, "%s\n", l + 6);
+    } else if (sscanf(l, "[SIM] LCD%u", &lin) == 1) {
+        quadrosLcd++;
+        fprintf(registro, "t=%lus %s\n", (unsigned long)halSegundos(), l + 6);
+    }
+    if (verboso) puts(l);
+}
+
+static void tarefaLoop(void*) {
+    setup();
+    for (;;) loop();   // loop() apaga a tarefa, como no firmware
+}
+
+static bool lerTraco(const char* arquivo) {
+    FILE* f = fopen(arquivo, "r");
+    if (!f) { perror(arquivo); return false; }
+    char linha[128];
+    while (fgets(linha, sizeof(linha), f)) {
+        PontoTraco p;
+        unsigned long s;
+        if (linha[0] == '#' || sscanf(linha, "%lu,%f,%f,%d", &s, &p.temp, &p.umid, &p.luz) != 4) continue;
+        p.t = s;
+        if (!tracoLido.empty() && p.t <= tracoLido.back().t) {
+            fprintf(stderr, "%s: tempos precisam crescer (%lu)\n", arquivo, s);
+            fclose(f);
+            return false;
+        }
+        tracoLido.push_back(p);
+    }
+    fclose(f);
+    if (tracoLido.size() < 2 || tracoLido[0].t != 0) {
+        fprintf(stderr, "%s: precisa de 2+ pontos, o primeiro no segundo 0\n", arquivo);
+        return false;
+    }
+    simTracoPontos = tracoLido.data();
+    simTracoTam    = tracoLido.size();
+    return true;
+}
+
+int main(int argc, char** argv) {
+    double              horas = 24;
+    std::vector<Espera> esperas;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (!strcmp(a, "-v")) { verboso = true; continue; }
+        if (i + 1 >= argc) uso();
+        const char* v = argv[++i];
+        if (!strcmp(a, "--traco")) {
+            if (!lerTraco(v)) return 2;
+        } else if (!strcmp(a, "--horas")) {
+            horas = atof(v);
+        } else if (!strcmp(a, "--registro")) {
+            if (!(registro = fopen(v, "w"))) { perror(v); return 2; }
+        } else if (!strcmp(a, "--espera")) {
+            unsigned hh, mm;
+            Espera   e = { 0, -1, -1, false };
+            if (sscanf(v, "%u:%u", &hh, &mm) != 2) uso();
+            e.t = hh * 3600 + mm * 60;
+            if (const char* p = strstr(v, "lampada=")) e.lampada = atoi(p + 8);
+            if (const char* p = strstr(v, "motor="))   e.motor   = atoi(p + 6);
+            esperas.push_back(e);
+        } else {
+            uso();
+        }
+    }
+
+    setenv("ESTUFA_PORTA", "0", 0);   // porta livre qualquer, a menos que pedida
+    hostSerialLinha = linhaSerial;
+    xTaskCreatePinnedToCore(tarefaLoop, "loopTask", 8192, nullptr, 1, nullptr, 1);
+
+    while (!server.porta()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    fprintf(registro, "# %gx tempo real, servidor em http://127.0.0.1:%u\n",
+            (double)SIM_ACELERACAO, server.porta());
+
+    int      falhas = 0;
+    uint32_t fim    = (uint32_t)(horas * 3600);
+    for (uint32_t t; (t = halSegundos()) < fim; ) {
+        for (Espera& e : esperas) {
+            if (e.conferida || t < e.t) continue;
+            e.conferida = true;
+            bool lamp = simReles[RELE_LAMPADA], mot = simReles[RELE_MOTOR];
+            bool ok   = (e.lampada < 0 || e.lampada == lamp) && (e.motor < 0 || e.motor == mot);
+            fprintf(registro, "t=%lus espera %02u:%02u lampada=%d motor=%d: %s\n", (unsigned long)t,
+                    e.t / 3600, e.t / 60 % 60, lamp, mot, ok ? "ok" : "FALHOU");
+            if (!ok) {
+                fprintf(stderr, "espera %02u:%02u falhou: lampada=%d motor=%d\n", e.t / 3600, e.t / 60 % 60, lamp, mot);
+                falhas++;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    fprintf(registro, "# fim em t=%lus: %u trocas da lampada, %u do motor, %u escritas no LCD\n",
+            (unsigned long)halSegundos(), trocas[0], trocas[1], quadrosLcd);
+    fflush(registro);
+    if (!trocas[0] || !trocas[1]) { fprintf(stderr, "nenhuma troca de relé em %g h\n", horas); falhas++; }
+    for (const Espera& e : esperas)
+        if (!e.conferida) { fprintf(stderr, "espera %02u:%02u depois do fim\n", e.t / 3600, e.t / 60 % 60); falhas++; }
+    fflush(stdout);
+    std::_Exit(falhas ? 1 : 0);   // as tarefas não terminam sozinhas
+}
@@ -0,0 +1,240 @@
+/*
+ * Carga no servidor web do firmware simulado e o que ela faz com o laço
+ * de controle: latência amostra → relé (latenciaFaixas, a mesma do
+ * Monitor Serie) em p50/p99, primeiro ocioso e depois com clientes
+ * concorrentes:
+ *
+ *   - RAPIDOS threads pedindo /api/data sem parar (uma conexão por pedido);
+ *   - LENTOS leitores da página inteira, 64 bytes a cada 10 ms, e LENTOS
+ *     de /api/history?step=3 (~50 KB em pedaços), 1 KB a cada 10 ms com
+ *     janela de 4 KB – a resposta não cabe no buffer do socket;
+ *   - SSE_MAX_CLIENTES assinantes de /api/stream que nunca leem (janela
+ *     TCP cheia – o servidor tem de pular frames, não travar).
+ *
+ * O firmware roda como em simular_firmware (setup()/loop() numa tarefa,
+ * SIM_ACELERACAO = 3600, uma amostra por ms); o servidor é TCP de verdade
+ * em 127.0.0.1. Com os leitores lentos ativos, o p99 de /api/data tem de
+ * ficar abaixo de DADOS_P99_MAX_US: um download não pode segurar os outros.
+ *
+ * Compilar: ver CMakeLists.txt (alvo teste_carga). Código de saída 1 em falha.
+ *
+ *     ./teste_carga [segundos de carga]     (padrão 4)
+ */
+#include "../../main.c"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define RAPIDOS        8
+#define LENTOS         2
+#define P99_MAX_US     5000    // "poucos ms" com qualquer número de clientes
+#define DADOS_P99_MAX_US 50000  // /api/data com os leitores lentos baixando ao mesmo tempo
+#define HIST_MIN_BYTES 40000    // /api/history?step=3: 1200 baldes da última hora
+
+typedef std::chrono::steady_clock Relogio;
+
+static uint16_t          porta;
+static std::atomic<bool> parar{false};
+
+static void linhaSerial(const char*) {}
+
+static void tarefaLoop(void*) {
+    setup();
+    for (;;) loop();
+}
+
+static int conectar(int rcvbuf = 0) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (rcvbuf) setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));   // antes do connect
+    timeval tv = { 5, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    sockaddr_in a = {};
+    a.sin_family      = AF_INET;
+    a.sin_port        = htons(porta);
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&a, sizeof(a)) < 0) { close(fd); return -1; }
+    return fd;
+}
+
+static bool pedir(int fd, const char* caminho) {
+    char req[128];
+    int  n = snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: estufa\r\nConnection: close\r\n\r\n", caminho);
+    return send(fd, req, n, MSG_NOSIGNAL) == n;
+}
+
+/** Lê até o servidor fechar; devolve os bytes ou -1. pausaMs > 0 = leitor lento. fim: últimos 8 bytes */
+static long lerTudo(int fd, size_t bloco, int pausaMs, char* fim = nullptr) {
+    char buf[4096];
+    long total = 0;
+    for (;;) {
+        ssize_t n = recv(fd, buf, std::min(bloco, sizeof(buf)), 0);
+        if (n == 0) return total;
+        if (n < 0)  return -1;
+        if (fim) {   // janela deslizante dos últimos 8 bytes
+            size_t k = std::min<size_t>(n, 8);
+            memmove(fim, fim + k, 8 - k);
+            memcpy(fim + 8 - k, buf + n - k, k);
+        }
+        total += n;
+        if (pausaMs) std::this_thread::sleep_for(std::chrono::milliseconds(pausaMs));
+    }
+}
+
+struct Cliente { std::vector<uint32_t> us; uint32_t erros = 0; long bytes = 0; };
+
+static void rapido(Cliente* c) {
+    while (!parar) {
+        auto t0 = Relogio::now();
+        int  fd = conectar();
+        long n  = (fd >= 0 && pedir(fd, "/api/data")) ? lerTudo(fd, 4096, 0) : -1;
+        if (fd >= 0) close(fd);
+        if (n <= 0) { c->erros++; continue; }
+        c->bytes += n;
+        c->us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Relogio::now() - t0).count());
+    }
+}
+
+static void lento(Cliente* c) {
+    while (!parar) {
+        auto t0 = Relogio::now();
+        int  fd = conectar();
+        long n  = (fd >= 0 && pedir(fd, "/")) ? lerTudo(fd, 64, 10) : -1;
+        if (fd >= 0) close(fd);
+        if (n < (long)PAGINA_GZ_TAM) { c->erros++; continue; }
+        c->bytes += n;
+        c->us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Relogio::now() - t0).count());
+    }
+}
+
+/** Histórico grande lido devagar por uma janela pequena; a resposta tem de chegar inteira (chunk final) */
+static void lentoHistorico(Cliente* c) {
+    while (!parar) {
+        auto t0 = Relogio::now();
+        char fim[8] = {};
+        int  fd = conectar(2048);   // o Linux dobra: janela de 4 KB
+        long n  = (fd >= 0 && pedir(fd, "/api/history?step=3")) ? lerTudo(fd, 1024, 10, fim) : -1;
+        if (fd >= 0) close(fd);
+        if (parar && n >= 0) break;   // cortado pelo fim do teste
+        if (n < HIST_MIN_BYTES || memcmp(fim, "}\r\n0\r\n\r\n", 8)) { c->erros++; continue; }
+        c->bytes += n;
+        c->us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Relogio::now() - t0).count());
+    }
+}
+
+/** Assinante de /api/stream que nunca lê: prende a conexão até o fim */
+static void travado(Cliente* c) {
+    int fd = conectar(1024);
+    if (fd < 0 || !pedir(fd, "/api/stream")) c->erros++;
+    while (!parar) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (fd >= 0) close(fd);
+}
+
+/**
+ * Espera os assinantes travados ocuparem os slots. O WebServer do host
+ * já fixa o buffer de envio no TCP_SND_BUF do lwIP (5744): sem isso o
+ * Linux cresceria o buffer e nem SSE nem downloads encheriam a janela.
+ */
+static void esperarSse() {
+    for (int i = 0; i < 200 && sseConectados < SSE_MAX_CLIENTES; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+static uint32_t percentil(std::vector<uint32_t>& v, int pct) {
+    if (v.empty()) return 0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, v.size() * pct / 100)];
+}
+
+struct Fase { uint32_t faixas[LAT_FAIXAS]; uint32_t amostras, perdidas, ssePulados; };
+
+static Fase medir(double segundos) {
+    Fase f, a;
+    memcpy(a.faixas, latenciaFaixas, sizeof(a.faixas));
+    a.perdidas = amostrasPerdidas;  a.ssePulados = sseFramesPulados;
+    std::this_thread::sleep_for(std::chrono::duration<double>(segundos));
+    f.amostras = 0;
+    for (int k = 0; k < LAT_FAIXAS; k++) { f.faixas[k] = latenciaFaixas[k] - a.faixas[k]; f.amostras += f.faixas[k]; }
+    f.perdidas   = amostrasPerdidas - a.perdidas;
+    f.ssePulados = sseFramesPulados - a.ssePulados;
+    return f;
+}
+
+static void imprimir(const char* nome, const Fase& f) {
+    printf("  %-8s %6u amostras  p50 <= %5u us  p99 <= %5u us  perdidas %u  frames SSE pulados %u\n", nome,
+           f.amostras, latenciaPercentil(f.faixas, 50), latenciaPercentil(f.faixas, 99), f.perdidas, f.ssePulados);
+}
+
+int main(int argc, char** argv) {
+    double segundos = argc > 1 ? atof(argv[1]) : 4;
+
+    setenv("ESTUFA_PORTA", "0", 0);
+    hostSerialLinha = linhaSerial;
+    xTaskCreatePinnedToCore(tarefaLoop, "loopTask", 8192, nullptr, 1, nullptr, 1);
+    while (!(porta = server.porta())) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));   // tarefas de pé, primeiras amostras
+
+    printf("latência amostra -> relé (ocioso %g s, carga %g s, %u núcleos):\n", segundos / 2, segundos,
+           std::thread::hardware_concurrency());
+    Fase ocioso = medir(segundos / 2);
+    imprimir("ocioso", ocioso);
+
+    // [0, RAPIDOS) /api/data | LENTOS / | LENTOS /api/history | SSE_MAX_CLIENTES travados
+    const int HIST = RAPIDOS + LENTOS, SSE = HIST + LENTOS;
+    std::vector<Cliente>     cli(SSE + SSE_MAX_CLIENTES);
+    std::vector<std::thread> ts;
+    for (int i = 0; i < SSE_MAX_CLIENTES; i++)  ts.emplace_back(travado, &cli[SSE + i]);
+    for (int i = 0; i < RAPIDOS; i++)           ts.emplace_back(rapido,  &cli[i]);
+    for (int i = 0; i < LENTOS; i++)            ts.emplace_back(lento,   &cli[RAPIDOS + i]);
+    for (int i = 0; i < LENTOS; i++)            ts.emplace_back(lentoHistorico, &cli[HIST + i]);
+    esperarSse();
+    Fase carga = medir(segundos);
+    uint8_t sseNoFim = sseConectados;
+    parar = true;
+    for (std::thread& t : ts) t.join();
+    imprimir("carga", carga);
+
+    std::vector<uint32_t> dados, paginas, historicos;
+    uint32_t errosDados = 0, errosPagina = 0, errosHist = 0, errosSse = 0;
+    long     bytesHist  = 0;
+    for (int i = 0; i < RAPIDOS; i++) { dados.insert(dados.end(), cli[i].us.begin(), cli[i].us.end()); errosDados += cli[i].erros; }
+    for (int i = 0; i < LENTOS; i++)  { paginas.insert(paginas.end(), cli[RAPIDOS + i].us.begin(), cli[RAPIDOS + i].us.end());
+                                        errosPagina += cli[RAPIDOS + i].erros; }
+    for (int i = 0; i < LENTOS; i++)  { historicos.insert(historicos.end(), cli[HIST + i].us.begin(), cli[HIST + i].us.end());
+                                        errosHist += cli[HIST + i].erros;  bytesHist += cli[HIST + i].bytes; }
+    for (int i = 0; i < SSE_MAX_CLIENTES; i++) errosSse += cli[SSE + i].erros;
+    uint32_t p99Dados = percentil(dados, 99);
+    printf("clientes: %d /api/data, %d leitores lentos de / e %d de /api/history, %d SSE travados (%u ainda conectados no fim)\n",
+           RAPIDOS, LENTOS, LENTOS, SSE_MAX_CLIENTES, sseNoFim);
+    printf("  /api/data  %6zu respostas (%.0f/s)  p50 %6u us  p99 %6u us  erros %u\n", dados.size(),
+           dados.size() / segundos, percentil(dados, 50), p99Dados, errosDados);
+    printf("  /          %6zu páginas            p50 %6u us  p99 %6u us  erros %u\n", paginas.size(),
+           percentil(paginas, 50), percentil(paginas, 99), errosPagina);
+    printf("  /api/hist  %6zu respostas (%ld B)   p50 %6u us  p99 %6u us  erros %u\n", historicos.size(),
+           historicos.empty() ? 0 : bytesHist / (long)historicos.size(), percentil(historicos, 50),
+           percentil(historicos, 99), errosHist);
+
+    int falhas = 0;
+    auto conferir = [&](bool ok, const char* msg) { if (!ok) { printf("FALHOU: %s\n", msg); falhas++; } };
+    conferir(ocioso.amostras > 0 && carga.amostras > 0, "o controle não registrou amostras");
+    conferir(latenciaPercentil(carga.faixas, 99) <= P99_MAX_US, "p99 do controle sob carga acima de P99_MAX_US");
+    conferir(dados.size() > 100 && errosDados == 0, "/api/data falhou sob carga");
+    conferir(!paginas.empty() && errosPagina == 0, "leitores lentos não receberam a página inteira");
+    conferir(!historicos.empty() && errosHist == 0, "leitores lentos não receberam o histórico inteiro");
+    conferir(p99Dados <= DADOS_P99_MAX_US, "p99 de /api/data com leitores lentos acima de DADOS_P99_MAX_US");
+    // travados só caem depois de SSE_TRAVADO_MS sem aceitar nada (o 1º EAGAIN vem logo após conectar)
+    conferir(errosSse == 0, "assinante SSE não conectou");
+    if (segundos * 1000 < SSE_TRAVADO_MS - 500)
+        conferir(sseNoFim == SSE_MAX_CLIENTES, "assinante SSE derrubado antes de SSE_TRAVADO_MS");
+    else if (segundos * 1000 > SSE_TRAVADO_MS + 1000)
+        conferir(sseNoFim == 0, "assinante SSE travado não foi derrubado");
+    conferir(carga.ssePulados > 0, "SSE travado não pulou frames (o teste não encheu a janela?)");
+    printf("%s\n", falhas ? "FALHOU" : "ok");
+    fflush(stdout);
+    std::_Exit(falhas ? 1 : 0);   // as tarefas não terminam sozinhas
+}
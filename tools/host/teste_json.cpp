@@ -0,0 +1,376 @@
+/*
+ * Teste e micro-benchmark do JsonBuf (escrita de JSON em buffer fixo).
+ *
+ *   - jsonInteiro / jsonDecimal1 contra snprintf e contra o dtostrf do
+ *     core (o que String(v,1) usava antes);
+ *   - truncamento: nenhum byte escrito além de cap, estouro sempre sinalizado;
+ *   - /api/data no pior caso cabe em JSON_TAM_ESTADO e é JSON válido;
+ *   - benchmark: concatenação de String da versão antiga contra JsonBuf,
+ *     em ns e alocações por resposta.
+ *
+ * Compilar: ver CMakeLists.txt (alvo teste_json). Código de saída 1 em falha.
+ */
+#include "../../main.c"
+#include "contar_alocacoes.h"
+
+#include <chrono>
+#include <climits>
+#include <random>
+
+static int falhas = 0;
+
+#define CONFERIR(cond, ...) do { if (!(cond)) { printf("FALHOU: " __VA_ARGS__); printf("\n"); falhas++; } } while (0)
+
+// ─────────────────────────────────────────────────────────
+//  Referência: o dtostrf e a String do Arduino-ESP32 2.x
+// ─────────────────────────────────────────────────────────
+
+/** dtostrf do core (stdlib_noniso.c), que String(v, casas) chamava */
+static char* dtostrfCore(double number, signed int width, unsigned int prec, char* s) {
+    if (isnan(number)) { strcpy(s, "nan"); return s; }
+    if (isinf(number)) { strcpy(s, "inf"); return s; }
+    char* out    = s;
+    int   fillme = width;
+    bool  negativo = number < 0.0;
+    if (negativo) { fillme--; number = -number; }
+    double rounding = 0.5;
+    for (unsigned i = 0; i < prec; ++i) rounding /= 10.0;
+    number += rounding;
+    double tenpow = 1.0;
+    int    digitcount = 1;
+    while (number >= 10.0 * tenpow) { tenpow *= 10.0; digitcount++; }
+    number /= tenpow;
+    fillme -= digitcount;
+    if (prec > 0) fillme -= (prec + 1);
+    while (fillme-- > 0) *out++ = ' ';
+    if (negativo) *out++ = '-';
+    digitcount += prec;
+    while (digitcount-- > 0) {
+        int digit = (int)number;
+        if (digit > 9) digit = 9;
+        *out++ = (char)('0' | digit);
+        if ((digitcount == (int)prec) && (prec > 0)) *out++ = '.';
+        number -= digit;
+        number *= 10.0;
+    }
+    *out = 0;
+    return s;
+}
+
+/**
+ * Réplica da alocação da WString do core: buffer do tamanho exato,
+ * realloc a cada concatenação que não cabe, String(float) com buffer
+ * temporário de 42 + casas bytes. Só o necessário para o handleGetData antigo.
+ */
+class StringLegado {
+    char*    buf = nullptr;
+    unsigned cap = 0, len = 0;
+
+    bool reservar(unsigned n) {
+        if (buf && cap >= n) return true;
+        char* p = (char*)realloc(buf, n + 1);
+        if (!p) return false;
+        if (!buf) p[0] = '\0';
+        buf = p;  cap = n;
+        return true;
+    }
+    void copiar(const char* s, unsigned n) {
+        if (!reservar(n)) return;
+        memcpy(buf, s, n);  buf[n] = '\0';  len = n;
+    }
+    void concatenar(const char* s, unsigned n) {
+        if (!reservar(len + n)) return;
+        memcpy(buf + len, s, n);  len += n;  buf[len] = '\0';
+    }
+
+  public:
+    StringLegado() {}
+    StringLegado(const char* s) { copiar(s, strlen(s)); }
+    StringLegado(const StringLegado& o) { copiar(o.c_str(), o.len); }
+    explicit StringLegado(int v) { char b[2 + 8 * sizeof(int)]; copiar(b, snprintf(b, sizeof(b), "%d", v)); }
+    StringLegado(float v, unsigned casas) {
+        char* b = (char*)malloc(casas + 42);
+        if (b) { dtostrfCore(v, casas + 2, casas, b); copiar(b, strlen(b)); free(b); }
+    }
+    ~StringLegado() { free(buf); }
+
+    void reserve(unsigned n) { reservar(n); }
+    StringLegado& operator=(const StringLegado& o) { if (this != &o) copiar(o.c_str(), o.len); return *this; }
+    StringLegado& operator+=(const StringLegado& o) { concatenar(o.c_str(), o.len); return *this; }
+    StringLegado& operator+=(const char* s) { concatenar(s, strlen(s)); return *this; }
+    friend StringLegado operator+(const char* a, const StringLegado& b) {   // StringSumHelper
+        StringLegado r(a);
+        r += b;
+        return r;
+    }
+    const char* c_str() const { return buf ? buf : ""; }
+    unsigned    length() const { return len; }
+};
+
+/** handleGetData da versão anterior ao JsonBuf, sem o envio */
+static unsigned jsonLegado(const EstadoEstufa& e, char* saida) {
+    StringLegado j;
+    j.reserve(256);
+    j  = "{\"temp\":"    + StringLegado(e.temperatura, 1);
+    j += ",\"umid\":"    + StringLegado(e.umidade, 1);
+    j += ",\"luz\":"     + StringLegado((int)e.pctLuz);
+    j += ",\"lampada\":" + StringLegado(e.lampada ? 1 : 0);
+    j += ",\"motor\":"   + StringLegado(e.motor   ? 1 : 0);
+    j += ",\"modoManual\":" + StringLegado(e.modoManual ? 1 : 0);
+    j += ",\"tempLigar\":"  + StringLegado(e.cfg.tempLigar,  1);
+    j += ",\"tempDeslig\":" + StringLegado(e.cfg.tempDeslig, 1);
+    j += ",\"umidLigar\":"  + StringLegado(e.cfg.umidLigar,  1);
+    j += ",\"umidDeslig\":" + StringLegado(e.cfg.umidDeslig, 1);
+    j += ",\"luzLigar\":"   + StringLegado(e.cfg.luzLigar);
+    j += ",\"luzDeslig\":"  + StringLegado(e.cfg.luzDeslig);
+    j += "}";
+    memcpy(saida, j.c_str(), j.length() + 1);
+    return j.length();
+}
+
+/** Os mesmos 12 campos com JsonBuf – comparação justa com jsonLegado */
+static size_t jsonMesmosCampos(const EstadoEstufa& e, char* buf, size_t cap) {
+    JsonBuf j;
+    jsonIniciar(j, buf, cap);
+    jsonTexto(j, "{\"temp\":");        jsonDecimal1(j, e.temperatura);
+    jsonTexto(j, ",\"umid\":");        jsonDecimal1(j, e.umidade);
+    jsonTexto(j, ",\"luz\":");         jsonInteiro(j, e.pctLuz);
+    jsonTexto(j, ",\"lampada\":");     jsonInteiro(j, e.lampada ? 1 : 0);
+    jsonTexto(j, ",\"motor\":");       jsonInteiro(j, e.motor   ? 1 : 0);
+    jsonTexto(j, ",\"modoManual\":");  jsonInteiro(j, e.modoManual ? 1 : 0);
+    jsonTexto(j, ",\"tempLigar\":");   jsonDecimal1(j, e.cfg.tempLigar);
+    jsonTexto(j, ",\"tempDeslig\":");  jsonDecimal1(j, e.cfg.tempDeslig);
+    jsonTexto(j, ",\"umidLigar\":");   jsonDecimal1(j, e.cfg.umidLigar);
+    jsonTexto(j, ",\"umidDeslig\":");  jsonDecimal1(j, e.cfg.umidDeslig);
+    jsonTexto(j, ",\"luzLigar\":");    jsonInteiro(j, e.cfg.luzLigar);
+    jsonTexto(j, ",\"luzDeslig\":");   jsonInteiro(j, e.cfg.luzDeslig);
+    jsonTexto(j, "}");
+    return j.estouro ? 0 : j.len;
+}
+
+// ─────────────────────────────────────────────────────────
+//  Validador de JSON (só o que o firmware emite)
+// ─────────────────────────────────────────────────────────
+static bool jsonValor(const char*& p);
+
+static bool jsonCadeia(const char*& p) {
+    if (*p++ != '"') return false;
+    while (*p && *p != '"') { if (*p == '\\' || (unsigned char)*p < 0x20) return false; p++; }
+    return *p++ == '"';
+}
+
+static bool jsonNumero(const char*& p) {
+    const char* ini = p;
+    if (*p == '-') p++;
+    if (!isdigit((unsigned char)*p)) return false;
+    if (*p == '0' && isdigit((unsigned char)p[1])) return false;   // zero à esquerda
+    while (isdigit((unsigned char)*p)) p++;
+    if (*p == '.') { p++; if (!isdigit((unsigned char)*p)) return false; while (isdigit((unsigned char)*p)) p++; }
+    return p > ini;
+}
+
+static bool jsonObjeto(const char*& p) {
+    if (*p++ != '{') return false;
+    if (*p == '}') { p++; return true; }
+    for (;;) {
+        if (!jsonCadeia(p) || *p++ != ':' || !jsonValor(p)) return false;
+        if (*p == '}') { p++; return true; }
+        if (*p++ != ',') return false;
+    }
+}
+
+static bool jsonValor(const char*& p) {
+    if (*p == '{') return jsonObjeto(p);
+    if (*p == '"') return jsonCadeia(p);
+    if (!strncmp(p, "null", 4)) { p += 4; return true; }
+    return jsonNumero(p);
+}
+
+static bool jsonValido(const char* s) { return jsonObjeto(s) && *s == '\0'; }
+
+// ─────────────────────────────────────────────────────────
+//  Testes
+// ─────────────────────────────────────────────────────────
+static void testarInteiros() {
+    const long casos[] = { 0, 1, -1, 9, 10, -10, 255, 65535, 4095, 100000,
+                           INT32_MAX, INT32_MIN, (long)UINT32_MAX, LONG_MAX, LONG_MIN };
+    for (long v : casos) {
+        char buf[32], esperado[32];
+        JsonBuf j;
+        jsonIniciar(j, buf, sizeof(buf));
+        jsonInteiro(j, v);
+        snprintf(esperado, sizeof(esperado), "%ld", v);
+        CONFERIR(!j.estouro && !strcmp(buf, esperado), "jsonInteiro(%ld) = \"%s\"", v, buf);
+    }
+}
+
+static void testarDecimais() {
+    // mesmo valor que String(v,1) dava; só o sinal de -0.0x difere ("0.0" contra "-0.0")
+    // e, nos empates exatos, jsonDecimal1 sempre arredonda para longe do zero
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> larga(-3276.7f, 6553.5f);
+    unsigned difs = 0, total = 0;
+    auto comparar = [&](float v) {
+        char buf[32], ref[48];
+        JsonBuf j;
+        jsonIniciar(j, buf, sizeof(buf));
+        jsonDecimal1(j, v);
+        dtostrfCore(v, 3, 1, ref);
+        const char* p   = buf;
+        double      dez = v * 10.0;
+        bool empate = dez - floor(dez) == 0.5;   // x.x5 exato: o dtostrf cai para qualquer lado
+        total++;
+        if (!jsonNumero(p) || *p ||
+            (fabs(strtod(buf, nullptr) - strtod(ref, nullptr)) > (empate ? 0.11 : 0.01))) {
+            if (difs++ < 5) printf("FALHOU: jsonDecimal1(%.7g) = \"%s\", String(v,1) = \"%s\"\n", v, buf, ref);
+        }
+    };
+    for (int d = -4000; d <= 15000; d++) comparar(d * 0.01f);         // -40.00 .. 150.00 °C / %
+    for (int d = -32767; d <= 65535; d++) comparar(d * 0.1f);          // toda leitura possível do DHT22
+    for (int i = 0; i < 200000; i++) comparar(larga(rng));
+    CONFERIR(difs == 0, "jsonDecimal1: %u de %u valores diferem de String(v,1)", difs, total);
+
+    const float especiais[] = { NAN, INFINITY, -INFINITY };
+    for (float v : especiais) {
+        char buf[8];
+        JsonBuf j;
+        jsonIniciar(j, buf, sizeof(buf));
+        jsonDecimal1(j, v);
+        CONFERIR(!strcmp(buf, "null"), "jsonDecimal1(%g) = \"%s\"", v, buf);
+    }
+}
+
+static void testarTruncamento() {
+    const char esperado[] = "{\"a\":-2147483648,\"b\":-3276.7,\"c\":null}";
+    const size_t n = sizeof(esperado) - 1;
+    for (size_t cap = 0; cap <= n + 2; cap++) {
+        char area[sizeof(esperado) + 16];
+        memset(area, 0x5A, sizeof(area));   // cap bytes úteis + canário depois
+        JsonBuf j;
+        jsonIniciar(j, area, cap);
+        jsonTexto(j, "{\"a\":");  jsonInteiro(j, INT32_MIN);
+        jsonTexto(j, ",\"b\":");  jsonDecimal1(j, -3276.7f);
+        jsonTexto(j, ",\"c\":");  jsonDecimal1(j, NAN);
+        jsonTexto(j, "}");
+        bool canario = true;
+        for (size_t i = cap; i < sizeof(area); i++) canario &= (uint8_t)area[i] == 0x5A;
+        CONFERIR(canario, "cap %zu: escreveu além do buffer", cap);
+        CONFERIR(j.estouro == (cap <= n), "cap %zu: estouro = %d", cap, j.estouro);
+        if (cap) CONFERIR(j.len < cap && area[j.len] == '\0' && !strncmp(area, esperado, j.len),
+                          "cap %zu: prefixo errado \"%.*s\"", cap, (int)j.len, area);
+    }
+}
+
+/** Maior /api/data possível: leituras extremas do DHT22, limites do handleSetConfig, contadores no máximo */
+static EstadoEstufa estadoPiorCaso() {
+    EstadoEstufa e;
+    memset(&e, 0, sizeof(e));
+    e.temperatura = -3276.7f;   // ((d[2]&0x7F)<<8 | d[3]) * 0.1 com o bit de sinal
+    e.umidade     = 6553.5f;    // (d[0]<<8 | d[1]) * 0.1
+    e.pctLuz      = 100;
+    e.lux         = 65535;
+    e.cfg         = { -40.0f, -40.0f, 100.0f, 100.0f, 100, 100 };
+    for (int s = 0; s < 4; s++) e.dhtContagem[s] = UINT32_MAX;
+    e.dhtUltimoBom      = halSegundos() + 1;   // idade = 2^32 - 1
+    e.dhtFalhasSeguidas = UINT16_MAX;
+    e.dhtStatus = 2;  e.saudeDht = SAUDE_IMPLAUSIVEL;  e.saudeLdr = SAUDE_IMPLAUSIVEL;   // nomes mais longos
+    e.lampada = e.motor = e.modoManual = true;
+    for (int c = 0; c < 2; c++) { e.releSuprimidos[c] = UINT32_MAX; e.releTrocasHora[c] = UINT8_MAX; e.relePendente[c] = true; }
+    return e;
+}
+
+static void testarEstado() {
+    static char buf[4096];
+    EstadoEstufa e;
+    size_t       n;
+    bool         noLimite, umAMenos;
+    uint32_t     s;
+    do {   // "idade" sai de halSegundos(), que anda 3600x mais rápido: tudo dentro do mesmo segundo
+        s = halSegundos();
+        e = estadoPiorCaso();
+        n = montarJsonEstado(buf, sizeof(buf), e);
+        // exatamente no limite: precisa de n + 1 (terminador); um a menos devolve 0, nunca JSON cortado
+        static char limite[4096];
+        noLimite = montarJsonEstado(limite, n + 1, e) == n;
+        umAMenos = montarJsonEstado(limite, n, e) == 0;
+    } while (halSegundos() != s);
+    printf("/api/data no pior caso: %zu bytes de %d (folga %zd)\n", n, JSON_TAM_ESTADO,
+           (ssize_t)JSON_TAM_ESTADO - 1 - (ssize_t)n);
+    CONFERIR(n > 0 && n < JSON_TAM_ESTADO, "pior caso de /api/data (%zu bytes) não cabe em JSON_TAM_ESTADO", n);
+    CONFERIR(jsonValido(buf), "pior caso de /api/data inválido: %s", buf);
+
+    CONFERIR(noLimite, "cap = n + 1 deveria caber");
+    CONFERIR(umAMenos, "cap = n deveria dar 0");
+    CONFERIR(montarJsonEstado(buf, 16, e) == 0, "cap = 16 deveria dar 0");
+
+    // sem leitura ainda: NaN vira null e o JSON continua válido
+    e.temperatura = e.umidade = NAN;
+    n = montarJsonEstado(buf, sizeof(buf), e);
+    CONFERIR(n && jsonValido(buf) && strstr(buf, "\"temp\":null,\"umid\":null"), "estado sem leitura: %s", buf);
+}
+
+// ─────────────────────────────────────────────────────────
+//  Benchmark
+// ─────────────────────────────────────────────────────────
+template<typename F>
+static void medir(const char* nome, const EstadoEstufa* estados, int nEstados, F montar,
+                  ContagemAlocacoes& porResposta) {
+    const int N = 200000;
+    static char buf[JSON_TAM_ESTADO];
+    volatile size_t soma = 0;
+    for (int i = 0; i < 1000; i++) soma += montar(estados[i % nEstados], buf);   // aquecimento
+    ContagemAlocacoes a = alocacoesAgora();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) soma += montar(estados[i % nEstados], buf);
+    auto t1 = std::chrono::steady_clock::now();
+    ContagemAlocacoes d = alocacoesDesde(a);
+    porResposta = { d.chamadas / N, d.bytes / N };
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    printf("  %-28s %8.0f ns  %5zu alocações  %6zu bytes alocados  (%zu bytes de JSON)\n",
+           nome, ns, porResposta.chamadas, porResposta.bytes, soma / (N + 1000));
+}
+
+static void benchmark() {
+    EstadoEstufa estados[64];
+    std::mt19937 rng(7);
+    for (EstadoEstufa& e : estados) {
+        memset(&e, 0, sizeof(e));
+        e.temperatura = 15 + (rng() % 250) * 0.1f;
+        e.umidade     = 40 + (rng() % 500) * 0.1f;
+        e.pctLuz      = rng() % 101;
+        e.lux         = rng() % 20000;
+        e.cfg         = { 28.0f, 26.0f, 80.0f, 70.0f, 30, 40 };
+        e.lampada     = rng() & 1;  e.motor = rng() & 1;
+        e.dhtUltimoBom = halSegundos();
+        e.dhtContagem[0] = rng() % 100000;
+    }
+    // os dois primeiros precisam dar o mesmo texto
+    char a[JSON_TAM_ESTADO], b[JSON_TAM_ESTADO];
+    for (const EstadoEstufa& e : estados) {
+        jsonLegado(e, a);
+        jsonMesmosCampos(e, b, sizeof(b));
+        CONFERIR(!strcmp(a, b), "String e JsonBuf divergem:\n  %s\n  %s", a, b);
+    }
+
+    ContagemAlocacoes legado, mesmos, completo;
+    printf("por resposta de /api/data:\n");
+    medir("String (antes, 12 campos)", estados, 64,
+          [](const EstadoEstufa& e, char* buf) -> size_t { return jsonLegado(e, buf); }, legado);
+    medir("JsonBuf (mesmos 12 campos)", estados, 64,
+          [](const EstadoEstufa& e, char* buf) { return jsonMesmosCampos(e, buf, JSON_TAM_ESTADO); }, mesmos);
+    medir("JsonBuf (montarJsonEstado)", estados, 64,
+          [](const EstadoEstufa& e, char* buf) { return montarJsonEstado(buf, JSON_TAM_ESTADO, e); }, completo);
+    CONFERIR(mesmos.chamadas == 0 && completo.chamadas == 0, "JsonBuf alocou no heap");
+    CONFERIR(legado.chamadas > 0, "a réplica da String deveria alocar");
+}
+
+int main() {
+    testarInteiros();
+    testarDecimais();
+    testarTruncamento();
+    testarEstado();
+    benchmark();
+    if (falhas) { printf("%d falha(s)\n", falhas); return 1; }
+    printf("ok\n");
+    return 0;
+}
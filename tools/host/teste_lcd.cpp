@@ -0,0 +1,195 @@
+/*
+ * Bytes no barramento I2C por atualização do LCD com o framebuffer
+ * sombra, contra a reescrita completa de antes (setCursor + 16
+ * caracteres por linha, todo segundo).
+ *
+ * A contagem é a do Wire do host (tools/host): cada transação que o
+ * driver em lote de main.c (lcdLote*, halLcdEnviar) fecha chega a
+ * hostI2cTransacao com os bytes do PCF8574 – endereço, bytes de
+ * preparo do RS e os pares dado|EN, dado. O teste decodifica esses
+ * bytes como o HD44780 (nibble na borda de descida do EN) num "vidro"
+ * próprio, que depois de cada lcdAtualizar() tem de ser igual ao quadro.
+ *
+ *   - um dia do traço padrão, uma passada por segundo com
+ *     displayPassada(), a mesma da tarefa do display;
+ *   - casos fixos: nada mudou (0 bytes), um dígito, o quadro inteiro.
+ *
+ * Compilar: ver CMakeLists.txt (alvo teste_lcd). Código de saída 1 em falha.
+ */
+#include "../../main.c"
+
+static int falhas = 0;
+
+#define CONFERIR(cond, ...) do { if (!(cond)) { printf("FALHOU: " __VA_ARGS__); printf("\n"); falhas++; } } while (0)
+
+// endereço + setCursor (preparo do RS + 2 nibbles) + 1 caractere (idem)
+#define BYTES_UM_DIGITO  (1 + 2 * (1 + 2 * 2))
+
+static void linhaSerial(const char*) {}
+
+// ── HD44780 do outro lado do PCF8574 ──────────────────────────
+static char    vidro[LCD_LINHAS][40];   // DDRAM: linha 0 em 0x00, linha 1 em 0x40
+static uint8_t ddram      = 0;
+static uint8_t pinos      = 0;          // o expansor segura o último byte entre transações
+static int     nibbleAlto = -1;         // 4 bits: primeiro o alto, depois o baixo
+static uint32_t maiorTransacao = 0, enderecoErrado = 0;
+
+static void hd44780(uint8_t v, bool rs) {
+    if (rs) {
+        vidro[ddram >= 0x40][ddram & 0x3F] = (char)v;
+        ddram = (ddram & 0x40) | ((ddram + 1) & 0x3F);
+    } else if (v == 0x01) {
+        memset(vidro, ' ', sizeof(vidro));
+        ddram = 0;
+    } else if (v & 0x80) {
+        ddram = v & 0x7F;
+    }
+}
+
+static void transacao(uint8_t endereco, const uint8_t* p, size_t n) {
+    if (endereco != LCD_ENDERECO) enderecoErrado++;
+    maiorTransacao = max(maiorTransacao, (uint32_t)n);
+    for (size_t i = 0; i < n; i++) {
+        if ((pinos & PCF_EN) && !(p[i] & PCF_EN)) {   // borda de descida: captura D4–D7
+            uint8_t nb = pinos >> 4;
+            if (nibbleAlto < 0) nibbleAlto = nb;
+            else { hd44780((uint8_t)(nibbleAlto << 4 | nb), pinos & PCF_RS);  nibbleAlto = -1; }
+        }
+        pinos = p[i];
+    }
+}
+
+/** Atualiza e devolve os bytes no barramento; confere que o vidro ficou igual ao quadro */
+static uint32_t atualizar(const char* caso) {
+    uint32_t antes = Wire.bytes, contados = lcdBytesBarramento;
+    lcdAtualizar();
+    for (uint8_t l = 0; l < LCD_LINHAS; l++)
+        CONFERIR(!memcmp(vidro[l], lcdQuadro[l], LCD_COLUNAS), "%s: linha %u do vidro |%.16s| != quadro |%.16s|",
+                 caso, l, vidro[l], lcdQuadro[l]);
+    CONFERIR(lcdBytesBarramento - contados == Wire.bytes - antes,
+             "%s: lcdBytesBarramento contou %u, o Wire viu %u", caso, lcdBytesBarramento - contados, Wire.bytes - antes);
+    return Wire.bytes - antes;
+}
+
+/** O que a versão anterior mandava a cada segundo, pelo mesmo driver: setCursor + 16 caracteres por linha */
+static uint32_t reescritaCompleta() {
+    uint32_t antes = Wire.bytes;
+    for (uint8_t l = 0; l < LCD_LINHAS; l++) {
+        halLcdCursor(0, l);
+        halLcdEscrever(lcdQuadro[l], LCD_COLUNAS);
+        halLcdEnviar();
+    }
+    return Wire.bytes - antes;
+}
+
+/** Leituras do traço padrão no segundo t, quantizadas como o DHT22 (0,1) */
+static void estadoNoTraco(EstadoEstufa& e, uint32_t t) {
+    const PontoTraco* p = SIM_TRACO_PADRAO;
+    size_t i = 0;
+    t %= 86400;
+    while (p[i + 1].t <= t) i++;
+    float f = (float)(t - p[i].t) / (p[i + 1].t - p[i].t);
+    e.temperatura = roundf((p[i].temp + (p[i + 1].temp - p[i].temp) * f) * 10) / 10;
+    e.umidade     = roundf((p[i].umid + (p[i + 1].umid - p[i].umid) * f) * 10) / 10;
+    e.pctLuz      = lroundf(p[i].luz + (p[i + 1].luz - p[i].luz) * f);
+    e.lux         = e.pctLuz * 650;
+    e.lampada     = e.pctLuz < 30;
+    e.motor       = e.temperatura > 28.0f;
+    if (isnan(e.tempMinDia) || e.temperatura < e.tempMinDia) e.tempMinDia = e.temperatura;
+    if (isnan(e.tempMaxDia) || e.temperatura > e.tempMaxDia) e.tempMaxDia = e.temperatura;
+    if (isnan(e.umidMinDia) || e.umidade < e.umidMinDia) e.umidMinDia = e.umidade;
+    if (isnan(e.umidMaxDia) || e.umidade > e.umidMaxDia) e.umidMaxDia = e.umidade;
+    e.lampSegDia += e.lampada;
+    e.motSegDia  += e.motor;
+    e.dhtUltimoBom = halSegundos();
+}
+
+static void dia(uint32_t bytesReescrita) {
+    EstadoEstufa e;
+    memset(&e, 0, sizeof(e));
+    e.tempMinDia = e.tempMaxDia = e.umidMinDia = e.umidMaxDia = NAN;
+
+    const uint32_t SEGUNDOS = 86400;
+    uint32_t bytes = 0, quadros = 0, maior = 0, bytesGiro = 0, giros = 0;
+    uint32_t transacoes = Wire.transacoes;
+    TelaDesenhada d = { -1, 0 };
+    lcdFlushes = lcdCelulas = lcdCursores = 0;
+    for (uint32_t t = 0; t < SEGUNDOS; t++) {
+        estadoNoTraco(e, t);
+        int      tl    = (t * 1000 / TEMPO_TELA) % NUM_TELAS;
+        bool     girou = tl != d.tela;
+        uint32_t antes = Wire.bytes;
+        if (!displayPassada(d, e, tl)) continue;
+        uint32_t b = Wire.bytes - antes;
+        for (uint8_t l = 0; l < LCD_LINHAS; l++)
+            CONFERIR(!memcmp(vidro[l], lcdQuadro[l], LCD_COLUNAS), "dia t=%u: linha %u do vidro |%.16s| != quadro |%.16s|",
+                     t, l, vidro[l], lcdQuadro[l]);
+        bytes += b;
+        quadros++;
+        if (girou) { bytesGiro += b; giros++; }
+        maior = max(maior, b);
+    }
+    transacoes = Wire.transacoes - transacoes;
+    uint32_t antes = SEGUNDOS * bytesReescrita;
+    printf("um dia, 1 passada/s, telas girando a cada %d s (bytes contados no Wire):\n", TEMPO_TELA / 1000);
+    printf("  antes:  %u bytes (%u por segundo, %u quadros)\n", antes, bytesReescrita, SEGUNDOS);
+    printf("  agora:  %u bytes (%.1f por segundo; %u quadros, %.1f bytes/quadro, pior %u)\n", bytes,
+           (double)bytes / SEGUNDOS, quadros, (double)bytes / quadros, maior);
+    printf("          %u giros de tela (%.1f bytes cada), %u quadros na mesma tela (%.1f bytes cada)\n",
+           giros, (double)bytesGiro / giros, quadros - giros, (double)(bytes - bytesGiro) / (quadros - giros));
+    printf("          %u transações, %u células, %u setCursor – %.1fx menos tráfego\n", transacoes,
+           lcdCelulas, lcdCursores, (double)antes / bytes);
+    CONFERIR(bytes * 10 <= antes, "menos de 10x de redução no dia (%u contra %u bytes)", bytes, antes);
+    CONFERIR(maior <= bytesReescrita, "um quadro custou %u bytes, mais que reescrever tudo (%u)",
+             maior, bytesReescrita);
+}
+
+static uint32_t casos() {
+    lcdLimpar();
+    CONFERIR(atualizar("vazio") == 0, "quadro limpo não deveria mandar nada");
+
+    EstadoEstufa e;
+    memset(&e, 0, sizeof(e));
+    e.temperatura = 25.3f;  e.umidade = 60;  e.pctLuz = 40;  e.lux = 26000;
+    mostrarDados(e);
+    uint32_t primeiro = atualizar("primeiro quadro");
+    uint32_t reescrita = reescritaCompleta();
+    mostrarDados(e);
+    uint32_t igual = atualizar("sem mudança");
+    e.temperatura = 25.4f;
+    mostrarDados(e);
+    uint32_t digito = atualizar("um dígito");
+    mostrarStatus(e);
+    uint32_t troca = atualizar("troca de tela");
+
+    // quadro inteiro diferente: pior caso do diff
+    memset(lcdQuadro, 'A', sizeof(lcdQuadro));  atualizar("tudo A");
+    memset(lcdQuadro, 'B', sizeof(lcdQuadro));
+    uint32_t transacoes = Wire.transacoes;
+    uint32_t tudo = atualizar("tudo B");
+    transacoes = Wire.transacoes - transacoes;
+
+    printf("casos (reescrita completa = %u bytes, bytes contados no Wire):\n", reescrita);
+    printf("  primeiro quadro %3u | sem mudança %3u | 25.3 -> 25.4 %3u | troca de tela %3u | tudo novo %3u em %u transações\n",
+           primeiro, igual, digito, troca, tudo, transacoes);
+    CONFERIR(igual == 0, "atualizar sem mudança mandou %u bytes", igual);
+    CONFERIR(digito == BYTES_UM_DIGITO, "um dígito deveria custar %u bytes (endereço + setCursor + 1 caractere), foram %u",
+             BYTES_UM_DIGITO, digito);
+    CONFERIR(tudo <= reescrita, "quadro inteiro custou %u bytes (> %u)", tudo, reescrita);
+    CONFERIR(reescrita == LCD_BYTES_REESCRITA, "reescrita completa: %u bytes no Wire, LCD_BYTES_REESCRITA = %u",
+             reescrita, LCD_BYTES_REESCRITA);
+    CONFERIR(transacoes <= 2, "quadro inteiro em %u transações", transacoes);
+    return reescrita;
+}
+
+int main() {
+    hostSerialLinha  = linhaSerial;
+    hostI2cTransacao = transacao;
+    uint32_t reescrita = casos();
+    dia(reescrita);
+    CONFERIR(enderecoErrado == 0, "%u transações fora do endereço do LCD", enderecoErrado);
+    CONFERIR(maiorTransacao <= LCD_LOTE, "transação de %u bytes (lote de %u)", maiorTransacao, LCD_LOTE);
+    if (falhas) { printf("%d falha(s)\n", falhas); return 1; }
+    printf("ok\n");
+    return 0;
+}
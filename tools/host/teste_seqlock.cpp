@@ -0,0 +1,136 @@
+/*
+ * Estresse do seqlock do EstadoEstufa: uma thread escritora chama
+ * publicarEstado() sem parar, com todos os campos derivados de um mesmo
+ * contador k; várias leitoras chamam lerEstado() e conferem que o
+ * snapshot inteiro veio da mesma publicação (nenhum campo de k e outro
+ * de k+1) e que a versão nunca volta.
+ *
+ * Para mostrar que o teste enxerga rasgos, a mesma verificação roda numa
+ * cópia ingênua das palavras, sem conferir a sequência (só informativo:
+ * com um único núcleo ela pode sair limpa).
+ *
+ * Antes do estresse, confere que só diagnóstico (contadores do DHT22,
+ * idade, segundos ligado) publica sem andar a versão e sem mudar o JSON
+ * do SSE – senão cada transação do DHT22 viraria um frame.
+ *
+ * Compilar: ver CMakeLists.txt (alvo teste_seqlock). Código de saída 1 em falha.
+ *
+ *     ./teste_seqlock [segundos]     (padrão 3)
+ */
+#include "../../main.c"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define LEITORAS 3
+
+static std::atomic<bool>     parar{false};
+static std::atomic<uint32_t> publicacoes{0};
+
+/** Todos os campos variáveis do snapshot saem de k */
+static void escrever(uint32_t k) {
+    temperatura = umidade = (float)(k & 0xFFFFF);   // exato em float
+    pctLuz = lux = (int)(k & 0xFFFFF);
+    for (int s = 0; s < 4; s++) dhtContagem[s] = k;
+    lampSegDia = motSegDia = k;
+    reles[RELE_LAMPADA].suprimidos = reles[RELE_MOTOR].suprimidos = k;
+    lampada = motor = k & 1;
+}
+
+/** Snapshot veio de uma única publicação? */
+static bool consistente(const EstadoEstufa& e) {
+    uint32_t k = e.dhtContagem[0];
+    bool ok = e.temperatura == (float)(k & 0xFFFFF) && e.umidade == e.temperatura &&
+              e.pctLuz == (int32_t)(k & 0xFFFFF) && e.lux == e.pctLuz &&
+              e.lampSegDia == k && e.motSegDia == k &&
+              e.releSuprimidos[0] == k && e.releSuprimidos[1] == k &&
+              e.lampada == (bool)(k & 1) && e.motor == e.lampada;
+    for (int s = 1; s < 4; s++) ok &= e.dhtContagem[s] == k;
+    return ok;
+}
+
+/** Diagnóstico andando sozinho não conta como mudança de estado */
+static bool soDiagnostico() {
+    char antes[JSON_TAM_ESTADO], depois[JSON_TAM_ESTADO];
+    EstadoEstufa e;
+    lerEstado(e);
+    size_t   na = montarJsonEstado(antes, sizeof(antes), e, false);
+    uint32_t v  = versaoEstado();
+
+    dhtContagem[DHT_OK]++;  dhtContagem[DHT_TIMEOUT]++;
+    saudeDht.ultimoBom++;   lampSegDia++;  reles[RELE_MOTOR].suprimidos++;
+    bool andou = publicarEstado();
+    lerEstado(e);
+    size_t nd = montarJsonEstado(depois, sizeof(depois), e, false);
+
+    bool ok = !andou && versaoEstado() == v && e.versao == v &&
+              e.dhtContagem[DHT_OK] == dhtContagem[DHT_OK] && e.lampSegDia == lampSegDia &&   // publicado mesmo assim
+              na && na == nd && !memcmp(antes, depois, na);
+    temperatura += 1;   // e o estado de verdade anda a versão
+    ok &= publicarEstado() && versaoEstado() == v + 1;
+    printf("só diagnóstico: versão %s, frame SSE %s\n", andou ? "andou" : "parada",
+           na == nd && !memcmp(antes, depois, na) ? "igual" : "mudou");
+    return ok;
+}
+
+static void escritora() {
+    for (uint32_t k = 1; !parar.load(std::memory_order_relaxed); k++) {
+        escrever(k);
+        if (publicarEstado()) publicacoes.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+struct Resultado { uint64_t leituras, rasgadas, voltou, ingenuas, ingenuasRasgadas; };
+
+static void leitora(Resultado* r) {
+    uint32_t ultima = 0;
+    while (!parar.load(std::memory_order_relaxed)) {
+        EstadoEstufa e;
+        lerEstado(e);
+        r->leituras++;
+        if (!consistente(e)) r->rasgadas++;
+        if (e.versao < ultima) r->voltou++;
+        ultima = e.versao;
+
+        // controle: a mesma cópia sem o protocolo do seqlock
+        uint32_t p[ESTADO_PALAVRAS];
+        for (size_t i = 0; i < ESTADO_PALAVRAS; i++) p[i] = estadoPalavras[i].load(std::memory_order_relaxed);
+        memcpy(&e, p, sizeof(e));
+        r->ingenuas++;
+        if (!consistente(e)) r->ingenuasRasgadas++;
+    }
+}
+
+int main(int argc, char** argv) {
+    double segundos = argc > 1 ? atof(argv[1]) : 3;
+
+    escrever(0);
+    publicarEstado();
+    bool diagOk = soDiagnostico();
+
+    std::vector<Resultado>    res(LEITORAS);
+    std::vector<std::thread>  ts;
+    ts.emplace_back(escritora);
+    for (int i = 0; i < LEITORAS; i++) ts.emplace_back(leitora, &res[i]);
+    std::this_thread::sleep_for(std::chrono::duration<double>(segundos));
+    parar = true;
+    for (std::thread& t : ts) t.join();
+
+    Resultado total = {};
+    for (const Resultado& r : res) {
+        total.leituras += r.leituras;   total.rasgadas += r.rasgadas;   total.voltou += r.voltou;
+        total.ingenuas += r.ingenuas;   total.ingenuasRasgadas += r.ingenuasRasgadas;
+    }
+    printf("%u publicações, %u threads (%u núcleos), %.1f s\n", publicacoes.load(), LEITORAS + 1,
+           std::thread::hardware_concurrency(), segundos);
+    printf("  lerEstado:     %llu leituras, %llu misturadas, %llu com versão voltando\n",
+           (unsigned long long)total.leituras, (unsigned long long)total.rasgadas,
+           (unsigned long long)total.voltou);
+    printf("  cópia ingênua: %llu leituras, %llu misturadas\n",
+           (unsigned long long)total.ingenuas, (unsigned long long)total.ingenuasRasgadas);
+
+    bool ok = diagOk && total.rasgadas == 0 && total.voltou == 0 && total.leituras > 0 && publicacoes > 1000;
+    printf("%s\n", ok ? "ok" : "FALHOU");
+    return ok ? 0 : 1;
+}
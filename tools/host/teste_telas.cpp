@@ -0,0 +1,111 @@
+/*
+ * Telas do LCD sem heap: desenha cada entrada de TELAS[] com milhares de
+ * estados (leituras extremas, NaN, contadores no máximo) e conta as
+ * alocações de desenhar() + assinatura() + lcdAtualizar(). Tem de dar 0.
+ *
+ * Confere também o contrato da tabela: dois estados com a mesma
+ * assinatura desenham o mesmo quadro – senão a tarefa do display
+ * deixaria uma mudança visível sem redesenhar.
+ *
+ * Compilar: ver CMakeLists.txt (alvo teste_telas). Código de saída 1 em falha.
+ */
+#include "../../main.c"
+#include "contar_alocacoes.h"
+
+#include <map>
+#include <random>
+#include <string>
+
+static int falhas = 0;
+
+#define CONFERIR(cond, ...) do { if (!(cond)) { printf("FALHOU: " __VA_ARGS__); printf("\n"); falhas++; } } while (0)
+
+static const char* const NOMES_TELAS[] = { "dados", "status", "rede", "saude", "hoje", "tempoReles", "clientes" };
+static_assert(sizeof(NOMES_TELAS) / sizeof(NOMES_TELAS[0]) == NUM_TELAS, "um nome por tela");
+
+static void linhaSerial(const char*) {}   // o LCD simulado imprime cada escrita; aqui não interessa
+
+/** Valor de uma lista pequena: estados repetem assinaturas com frequência */
+template<typename T, size_t N>
+static T sortear(std::mt19937& rng, const T (&v)[N]) { return v[rng() % N]; }
+
+static EstadoEstufa estadoAleatorio(std::mt19937& rng) {
+    // vizinhos de cada meio décimo: float e double arredondam diferente em alguns (-39.85f)
+    static const float temps[] = { NAN, -40.0f, -39.9f, -39.85f, -39.8f, -39.75f, -9.95f, -0.04f, 0.0f,
+                                   0.05f, 21.25f, 24.9f, 24.95f, 25.0f, 25.05f, 25.1f, 99.95f, 999.9f, -3276.7f };
+    static const float umids[] = { NAN, 0.0f, 0.5f, 1.5f, 49.5f, 50.0f, 99.4f, 99.5f, 100.0f, 6553.5f };
+    static const uint32_t segs[] = { 0, 59, 60, 3599, 3600, 86399, 359999, 360000, UINT32_MAX };
+    EstadoEstufa e;
+    memset(&e, 0, sizeof(e));
+    e.temperatura = sortear(rng, temps);
+    e.umidade     = sortear(rng, umids);
+    e.pctLuz      = rng() % 3 ? rng() % 101 : 100;
+    e.lux         = rng() % 3 ? rng() % 1000 : 65535;
+    e.tempMinDia  = sortear(rng, temps);  e.tempMaxDia = sortear(rng, temps);
+    e.umidMinDia  = sortear(rng, umids);  e.umidMaxDia = sortear(rng, umids);
+    e.lampSegDia  = sortear(rng, segs);   e.motSegDia  = sortear(rng, segs);
+    e.lampada     = rng() & 1;  e.motor = rng() & 1;  e.modoManual = rng() & 1;
+    e.saudeDht    = rng() % 4;  e.saudeLdr = rng() % 4;
+    e.dhtFalhasSeguidas = rng() % 2 ? rng() % 10 : UINT16_MAX;
+    e.dhtUltimoBom      = halSegundos() - (rng() % 3 ? rng() % 100 : 5000);
+    return e;
+}
+
+int main() {
+    hostSerialLinha = linhaSerial;
+    lcdLimpar();
+
+    ContagemAlocacoes a0 = alocacoesAgora();
+    void* volatile p = malloc(64);   // volatile: o compilador não pode sumir com o par
+    free(p);
+    CONFERIR(alocacoesDesde(a0).chamadas == 1, "o contador de alocações não enxerga malloc");
+
+    // aquecimento: a linha do Serial do host e o que mais crescer na 1ª vez
+    std::mt19937 rng(1);
+    for (unsigned t = 0; t < NUM_TELAS; t++) {
+        EstadoEstufa e = estadoAleatorio(rng);
+        TELAS[t].desenhar(e);  TELAS[t].assinatura(e);  lcdAtualizar();
+    }
+
+    const int ESTADOS = 20000;
+    printf("%d estados por tela:\n", ESTADOS);
+    for (unsigned t = 0; t < NUM_TELAS; t++) {
+        const Tela& tl = TELAS[t];
+        std::map<uint32_t, std::string> quadroPorAssinatura;
+        size_t   alocacoes = 0, bytes = 0;
+        unsigned conflitos = 0;
+        for (int i = 0; i < ESTADOS; i++) {
+            EstadoEstufa e = estadoAleatorio(rng);
+
+            ContagemAlocacoes a = alocacoesAgora();
+            uint32_t assin = tl.assinatura(e);
+            tl.desenhar(e);
+            lcdAtualizar();
+            uint32_t depois = tl.assinatura(e);   // a idade do DHT anda sozinha
+            ContagemAlocacoes d = alocacoesDesde(a);
+            alocacoes += d.chamadas;
+            bytes     += d.bytes;
+
+            for (uint8_t l = 0; l < LCD_LINHAS; l++)
+                for (uint8_t c = 0; c < LCD_COLUNAS; c++)
+                    CONFERIR(isprint((unsigned char)lcdQuadro[l][c]), "tela %s: caractere 0x%02x em %u,%u",
+                             NOMES_TELAS[t], (uint8_t)lcdQuadro[l][c], l, c);
+            if (assin != depois) continue;   // o relógio virou no meio
+
+            std::string quadro(&lcdQuadro[0][0], sizeof(lcdQuadro));
+            auto r = quadroPorAssinatura.emplace(assin, quadro);
+            if (!r.second && r.first->second != quadro && conflitos++ < 3)
+                printf("FALHOU: tela %s, mesma assinatura e quadros diferentes:\n  |%.16s|%.16s|\n  |%.16s|%.16s|\n",
+                       NOMES_TELAS[t], r.first->second.c_str(), r.first->second.c_str() + LCD_COLUNAS,
+                       quadro.c_str(), quadro.c_str() + LCD_COLUNAS);
+        }
+        printf("  %-11s %zu alocações (%zu bytes), %zu quadros distintos\n", NOMES_TELAS[t], alocacoes, bytes,
+               quadroPorAssinatura.size());
+        CONFERIR(alocacoes == 0, "tela %s alocou no heap", NOMES_TELAS[t]);
+        CONFERIR(conflitos == 0, "tela %s: %u conflitos de assinatura", NOMES_TELAS[t], conflitos);
+    }
+
+    if (falhas) { printf("%d falha(s)\n", falhas); return 1; }
+    printf("ok\n");
+    return 0;
+}
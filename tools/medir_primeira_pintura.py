@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""
+Tempo até a primeira pintura do dashboard numa rede sem internet (o AP
+Estufa_ESP32), antes e depois de tirar o @import do Google Fonts.
+
+Para cada versão da página:
+
+  1. serve o HTML como o firmware (gzip, mesmos cabeçalhos) num servidor
+     local – ou busca de --url, ex. o simular_firmware ou a placa em
+     http://192.168.4.1/ – e mede o tempo até o HTML inteiro chegar;
+  2. lista o que o navegador baixa ANTES de pintar (CSS por <link> ou
+     @import, <script src> síncrono) e o que ele busca fora do AP
+     (fontes, imagens, fetch com URL absoluta);
+  3. sem internet, cada recurso bloqueante num host externo só falha
+     quando o navegador desiste de resolver/conectar (--limite, padrão
+     10 s): a primeira pintura fica em HTML + o maior desses bloqueios.
+
+O passo 3 é um modelo – este script não abre navegador. O que ele mede
+de verdade é o HTML; o que ele garante é que a página atual não depende
+de nada fora do ESP32.
+
+    python3 tools/medir_primeira_pintura.py                     # página atual
+    python3 tools/medir_primeira_pintura.py --antes 77f041f     # + versão do git
+    python3 tools/medir_primeira_pintura.py --url http://192.168.4.1/
+    python3 tools/medir_primeira_pintura.py --verificar         # para o ctest
+
+--verificar sai com 1 se a página atual tiver recurso externo ou se
+pagina_gz.h não corresponder a web/index.html (esqueceram de rodar
+tools/gerar_pagina.py).
+"""
+import argparse
+import gzip
+import hashlib
+import html.parser
+import http.server
+import pathlib
+import re
+import subprocess
+import sys
+import threading
+import time
+import urllib.parse
+import urllib.request
+
+RAIZ    = pathlib.Path(__file__).resolve().parent.parent
+PAGINA  = RAIZ / "web" / "index.html"
+GERADO  = RAIZ / "pagina_gz.h"
+
+RE_IMPORT = re.compile(r"""@import\s+(?:url\(\s*(['"]?)(.*?)\1\s*\)|(['"])(.*?)\3)""", re.I)
+RE_URL    = re.compile(r"""url\(\s*(['"]?)(.*?)\1\s*\)""", re.I)
+RE_FETCH  = re.compile(r"""(?:fetch|EventSource|WebSocket)\s*\(\s*['"`]((?:https?|wss?):[^'"`]+)""")
+
+
+class Recursos(html.parser.HTMLParser):
+    """Coleta (url, tipo, bloqueia) do que o navegador busca para a página"""
+
+    def __init__(self):
+        super().__init__()
+        self.recursos = []
+        self.noHead   = True
+        self.bloco    = None   # "style" ou "script" em andamento
+        self.texto    = []
+
+    def handle_starttag(self, tag, attrs):
+        a = dict(attrs)
+        if tag == "body":
+            self.noHead = False
+        elif tag == "link" and "stylesheet" in (a.get("rel") or "").lower() and a.get("href"):
+            self.recursos.append((a["href"], "<link> CSS", a.get("media", "all") in ("all", "screen")))
+        elif tag == "link" and (a.get("rel") or "").lower() in ("icon", "preload", "manifest") and a.get("href"):
+            self.recursos.append((a["href"], "<link %s>" % a["rel"], False))
+        elif tag == "script" and a.get("src"):
+            sincrono = "async" not in a and "defer" not in a and a.get("type") != "module"
+            self.recursos.append((a["src"], "<script src>", sincrono and self.noHead))
+        elif tag in ("img", "iframe", "audio", "video", "source") and a.get("src"):
+            self.recursos.append((a["src"], "<%s>" % tag, False))
+        if tag in ("style", "script") and not a.get("src"):
+            self.bloco, self.texto = tag, []
+
+    def handle_data(self, data):
+        if self.bloco:
+            self.texto.append(data)
+
+    def handle_endtag(self, tag):
+        if tag != self.bloco:
+            return
+        texto = "".join(self.texto)
+        if tag == "style":
+            for m in RE_IMPORT.finditer(texto):
+                self.recursos.append((m.group(2) or m.group(4), "@import CSS", True))
+            sem = RE_IMPORT.sub("", texto)
+            for m in RE_URL.finditer(sem):
+                self.recursos.append((m.group(2), "url() no CSS", False))
+        else:
+            for m in RE_FETCH.finditer(texto):
+                self.recursos.append((m.group(1), "fetch/stream", False))
+        self.bloco = None
+
+
+def externo(url, base):
+    """URL fora do host que serviu a página?"""
+    alvo = urllib.parse.urlparse(urllib.parse.urljoin(base, url))
+    return alvo.scheme not in ("", "data", "blob") and alvo.netloc != urllib.parse.urlparse(base).netloc
+
+
+class ServidorPagina(http.server.BaseHTTPRequestHandler):
+    """Responde / como o handleRoot do firmware: gzip, ETag, no-cache"""
+    gz, etag = b"", ""
+
+    def do_GET(self):
+        self.send_response(200)
+        self.send_header("Content-Type", "text/html; charset=utf-8")
+        self.send_header("Content-Encoding", "gzip")
+        self.send_header("Content-Length", str(len(self.gz)))
+        self.send_header("ETag", self.etag)
+        self.send_header("Cache-Control", "no-cache")
+        self.end_headers()
+        self.wfile.write(self.gz)
+
+    def log_message(self, *_):
+        pass
+
+
+def buscar(url, repeticoes=20):
+    """(html, bytes na rede, melhor tempo em s) – mediana seria mais justa, o melhor é mais estável"""
+    melhor = None
+    for _ in range(repeticoes):
+        pedido = urllib.request.Request(url, headers={"Accept-Encoding": "gzip"})
+        t0 = time.perf_counter()
+        with urllib.request.urlopen(pedido, timeout=10) as r:
+            corpo = r.read()
+            gzipado = r.headers.get("Content-Encoding") == "gzip"
+        dt = time.perf_counter() - t0
+        melhor = dt if melhor is None else min(melhor, dt)
+    return (gzip.decompress(corpo) if gzipado else corpo).decode("utf-8"), len(corpo), melhor
+
+
+def servir(html_bytes):
+    """Sobe um servidor local com a página; devolve (url, servidor)"""
+    Manipulador = type("Manipulador", (ServidorPagina,), {
+        "gz":   gzip.compress(html_bytes, compresslevel=9, mtime=0),
+        "etag": '"%s"' % hashlib.sha256(html_bytes).hexdigest()[:16],
+    })
+    srv = http.server.ThreadingHTTPServer(("127.0.0.1", 0), Manipulador)
+    threading.Thread(target=srv.serve_forever, daemon=True).start()
+    return "http://127.0.0.1:%d/" % srv.server_address[1], srv
+
+
+def analisar(nome, url, limite):
+    """Mede e imprime uma versão; devolve (recursos externos, 1ª pintura em s)"""
+    pagina, rede, t_html = buscar(url)
+    p = Recursos()
+    p.feed(pagina)
+    externos   = [(u, tipo, bloq) for (u, tipo, bloq) in p.recursos if externo(u, url)]
+    bloqueios  = [r for r in externos if r[2]]
+    primeira   = t_html + (limite if bloqueios else 0.0)
+
+    print("%s  (%s)" % (nome, url))
+    print("  HTML: %d bytes na rede, %d descomprimido, %.1f ms até chegar inteiro"
+          % (rede, len(pagina.encode("utf-8")), t_html * 1000))
+    for u, tipo, bloq in externos:
+        print("  %-9s %-14s %s" % ("BLOQUEIA" if bloq else "externo", tipo, u))
+    if not externos:
+        print("  nenhum recurso fora do ESP32")
+    if bloqueios:
+        print("  1ª pintura sem internet: >= %.1f s (HTML + %.0f s até o navegador desistir de %s)"
+              % (primeira, limite, urllib.parse.urlparse(bloqueios[0][0]).netloc))
+    else:
+        print("  1ª pintura sem internet: %.1f ms (só o HTML)" % (primeira * 1000))
+    return externos, primeira
+
+
+def conferir_gerado():
+    """pagina_gz.h foi gerado a partir do web/index.html atual?"""
+    html_bytes = PAGINA.read_bytes()
+    texto = GERADO.read_text(encoding="utf-8")
+    etag  = re.search(r'#define PAGINA_ETAG "\\"([0-9a-f]+)\\""', texto).group(1)
+    bloco = texto[texto.index("PAGINA_GZ[] PROGMEM = {"):]
+    gz    = bytes(int(h, 16) for h in re.findall(r"0x([0-9a-f]{2})", bloco))
+    return etag == hashlib.sha256(html_bytes).hexdigest()[:16] and gzip.decompress(gz) == html_bytes
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--antes", metavar="REV", help="revisão do git com a página antiga (ex.: 77f041f)")
+    ap.add_argument("--url", help="buscar a página atual desta URL em vez do servidor local")
+    ap.add_argument("--limite", type=float, default=10.0,
+                    help="s até o navegador desistir de um host sem resposta (padrão 10)")
+    ap.add_argument("--verificar", action="store_true",
+                    help="falha se a página atual tiver recurso externo ou pagina_gz.h estiver velho")
+    args = ap.parse_args()
+
+    resultados = []
+    if args.antes:
+        antigo = subprocess.run(["git", "-C", str(RAIZ), "show", "%s:web/index.html" % args.antes],
+                                check=True, capture_output=True).stdout
+        url, srv = servir(antigo)
+        resultados.append(analisar("antes (%s)" % args.antes, url, args.limite))
+        srv.shutdown()
+
+    if args.url:
+        atual = analisar("atual", args.url, args.limite)
+    else:
+        url, srv = servir(PAGINA.read_bytes())
+        atual = analisar("atual (web/index.html)", url, args.limite)
+        srv.shutdown()
+    resultados.append(atual)
+
+    if len(resultados) == 2:
+        print("1ª pintura sem internet: %.1f s -> %.1f ms"
+              % (resultados[0][1], resultados[1][1] * 1000))
+
+    if args.verificar:
+        falhas = 0
+        if atual[0]:
+            print("FALHOU: a página atual busca recursos fora do ESP32")
+            falhas += 1
+        if not conferir_gerado():
+            print("FALHOU: pagina_gz.h não corresponde a web/index.html – rode tools/gerar_pagina.py")
+            falhas += 1
+        print("ok" if not falhas else "%d falha(s)" % falhas)
+        sys.exit(1 if falhas else 0)
+
+
+if __name__ == "__main__":
+    main()
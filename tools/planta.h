@@ -0,0 +1,191 @@
+// ══════════════════════════════════════════════════════════
+//  MODELO DA ESTUFA PARA SIMULAÇÃO NO PC
+//  Balanço térmico e de umidade de primeira ordem, curva solar
+//  dia/noite e clima externo (sintético ou lido de CSV). A cada
+//  passo os "sensores" leem o modelo e decidirReles() + releAplicar()
+//  – as mesmas funções de controlar() no firmware – decidem os relés.
+// ══════════════════════════════════════════════════════════
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "../controle.h"
+
+// ──────────────────────────────────────────────────────────
+//  PARÂMETROS FÍSICOS (estufa pequena, ~2 m³)
+// ──────────────────────────────────────────────────────────
+struct ParamPlanta {
+    float capTermica   = 60000;  // J/K  – ar + estrutura + vasos
+    float perdaUA      = 15;     // W/K  – troca pelas paredes/cobertura
+    float ganhoSolar   = 350;    // W    – pico ao meio-dia sem nuvens
+    float calorLampada = 40;     // W    – parte da lâmpada que vira calor interno
+    float vazaoMotor   = 60;     // W/K  – troca extra com o ventilador ligado
+    float potLampada   = 50;     // W elétricos
+    float potMotor     = 30;     // W elétricos
+    float evapBase     = 1.0f;   // %UR/h – transpiração à noite
+    float evapSolar    = 8.0f;   // %UR/h – transpiração extra com sol pleno
+    float trocaUmid    = 0.3f;   // 1/h   – renovação passiva do ar
+    float trocaMotor   = 4.0f;   // 1/h   – renovação extra com o ventilador
+    float luzLampada   = 8;      // %     – quanto a lâmpada soma na leitura do LDR
+                                 //         (> histérese de luz ⇒ a lâmpada oscila)
+    float ruidoTemp    = 0.1f;   // °C    – ruído do DHT22 (uniforme ±)
+    float ruidoUmid    = 0.5f;   // %
+    float ruidoLuz     = 1.0f;   // %
+};
+
+// ──────────────────────────────────────────────────────────
+//  CLIMA EXTERNO – traço amostrado, interpolado e repetido
+// ──────────────────────────────────────────────────────────
+struct Clima { float temp, umid, sol; };   // sol: 0 (noite) .. 1 (sol pleno)
+
+struct TracoClima {
+    std::vector<uint32_t> seg;           // crescente, começa em 0
+    std::vector<Clima>    val;
+    uint32_t              periodo = 0;   // o traço se repete após este tempo
+
+    Clima em(uint32_t t, size_t& cursor) const {
+        t %= periodo;
+        if (cursor >= seg.size() || seg[cursor] > t) cursor = 0;
+        while (cursor + 1 < seg.size() && seg[cursor + 1] <= t) cursor++;
+        size_t prox = cursor + 1 < seg.size() ? cursor + 1 : 0;
+        uint32_t t1 = prox ? seg[prox] : periodo;
+        float f = t1 > seg[cursor] ? float(t - seg[cursor]) / float(t1 - seg[cursor]) : 0;
+        const Clima& a = val[cursor];
+        const Clima& b = val[prox];
+        return { a.temp + (b.temp - a.temp) * f,
+                 a.umid + (b.umid - a.umid) * f,
+                 a.sol  + (b.sol  - a.sol ) * f };
+    }
+};
+
+/** Gerador congruente simples – resultados reproduzíveis com a mesma semente */
+struct Aleatorio {
+    uint32_t s;
+    explicit Aleatorio(uint32_t semente) : s(semente ? semente : 1) {}
+    float uniforme() { s = s * 1664525u + 1013904223u; return (s >> 8) * (1.0f / 16777216.0f); }
+    float entre(float a, float b) { return a + (b - a) * uniforme(); }
+};
+
+/** Clima sintético: média/amplitude/nebulosidade sorteadas por dia, amostra a cada 10 min */
+inline TracoClima climaSintetico(uint32_t dias, uint32_t semente) {
+    const uint32_t PASSO = 600;
+    TracoClima c;
+    Aleatorio rnd(semente);
+    for (uint32_t d = 0; d < dias; d++) {
+        float media = rnd.entre(19, 27);
+        float ampl  = rnd.entre(4, 9);
+        float nuvem = rnd.entre(0.3f, 1.0f);     // fração do sol que passa
+        float umidM = rnd.entre(55, 80);
+        for (uint32_t s = 0; s < 86400; s += PASSO) {
+            float h  = s / 3600.0f;
+            float te = media + ampl * cosf(2 * float(M_PI) * (h - 15) / 24);   // máx. às 15 h
+            float ue = std::min(100.0f, std::max(25.0f, umidM - 3 * (te - media)));
+            float so = (h > 6 && h < 18) ? nuvem * sinf(float(M_PI) * (h - 6) / 12) : 0;
+            c.seg.push_back(d * 86400 + s);
+            c.val.push_back({ te, ue, so });
+        }
+    }
+    c.periodo = dias * 86400;
+    return c;
+}
+
+/**
+ * Lê um traço CSV "segundo,temp,umid,sol" (cabeçalho e linhas com '#'
+ * são ignorados). O traço é repetido se a simulação for mais longa.
+ */
+inline bool climaCsv(const char* arquivo, TracoClima& c) {
+    FILE* f = fopen(arquivo, "r");
+    if (!f) return false;
+    char linha[160];
+    while (fgets(linha, sizeof(linha), f)) {
+        unsigned long s; float te, ue, so;
+        if (linha[0] == '#' || sscanf(linha, "%lu,%f,%f,%f", &s, &te, &ue, &so) != 4) continue;
+        if (!c.seg.empty() && s <= c.seg.back()) continue;
+        c.seg.push_back(uint32_t(s));
+        c.val.push_back({ te, ue, so });
+    }
+    fclose(f);
+    if (c.seg.size() < 2) return false;
+    // desloca para começar em 0 e fecha o período com o mesmo espaçamento do fim
+    uint32_t t0 = c.seg.front();
+    for (auto& s : c.seg) s -= t0;
+    c.periodo = c.seg.back() + (c.seg.back() - c.seg[c.seg.size() - 2]);
+    return true;
+}
+
+// ──────────────────────────────────────────────────────────
+//  SIMULAÇÃO
+// ──────────────────────────────────────────────────────────
+struct Cenario {
+    uint32_t dias    = 30;
+    uint32_t passo   = 1;                   // s – mesmo período de leitura do firmware
+    uint32_t semente = 1;                   // ruído dos sensores
+    float    tempMin = 18, tempMax = 30;    // faixa de conforto
+    float    umidMin = 50, umidMax = 80;
+    LimiteRele limLamp = { LAMP_MIN_LIGADA_S,  LAMP_MIN_DESLIG_S,  LAMP_MAX_POR_HORA  };
+    LimiteRele limMot  = { MOTOR_MIN_LIGADO_S, MOTOR_MIN_DESLIG_S, MOTOR_MAX_POR_HORA };
+};
+
+struct ResultadoSim {
+    uint32_t trocasLamp = 0, trocasMot = 0;
+    uint32_t suprLamp = 0, suprMot = 0;     // trocas seguradas pela proteção
+    uint32_t segForaTemp = 0, segForaUmid = 0;
+    uint32_t segLamp = 0, segMot = 0;
+    float    energiaWh = 0;
+    float    tempMin = 1e9f, tempMax = -1e9f;
+};
+
+inline ResultadoSim simular(const Limiares& cfg, const ParamPlanta& p,
+                            const TracoClima& clima, const Cenario& cen) {
+    ResultadoSim r;
+    Aleatorio rnd(cen.semente);
+    size_t cursor = 0;
+    const float dt = float(cen.passo);
+
+    Clima ini = clima.em(0, cursor);
+    float temp = ini.temp, umid = ini.umid;
+    bool  lampada = false, motor = false;
+    EstadoRele rl = {}, rm = {};
+
+    const uint32_t fim = cen.dias * 86400;
+    for (uint32_t t = 0; t < fim; t += cen.passo) {
+        Clima ext = clima.em(t, cursor);
+
+        // leitura dos sensores (com ruído) e decisão – igual a controlar()
+        float lt = temp + rnd.entre(-p.ruidoTemp, p.ruidoTemp);
+        float lu = umid + rnd.entre(-p.ruidoUmid, p.ruidoUmid);
+        float ll = 100 * ext.sol + (lampada ? p.luzLampada : 0) + rnd.entre(-p.ruidoLuz, p.ruidoLuz);
+        int   luz = int(std::min(100.0f, std::max(0.0f, ll)));
+
+        bool querL = lampada, querM = motor;
+        decidirReles(cfg, lt, lu, luz, querL, querM);
+        r.trocasLamp += releAplicar(rl, cen.limLamp, querL, t);
+        r.trocasMot  += releAplicar(rm, cen.limMot,  querM, t);
+        lampada = rl.ligado;
+        motor   = rm.ligado;
+
+        // planta – Euler explícito
+        float ua = p.perdaUA + (motor ? p.vazaoMotor : 0);
+        float q  = ua * (ext.temp - temp) + p.ganhoSolar * ext.sol + (lampada ? p.calorLampada : 0);
+        temp += q / p.capTermica * dt;
+
+        float evap  = p.evapBase + p.evapSolar * ext.sol;
+        float troca = p.trocaUmid + (motor ? p.trocaMotor : 0);
+        umid += (evap - troca * (umid - ext.umid)) / 3600 * dt;
+        umid  = std::min(100.0f, std::max(0.0f, umid));
+
+        // métricas
+        if (temp < cen.tempMin || temp > cen.tempMax) r.segForaTemp += cen.passo;
+        if (umid < cen.umidMin || umid > cen.umidMax) r.segForaUmid += cen.passo;
+        if (lampada) r.segLamp += cen.passo;
+        if (motor)   r.segMot  += cen.passo;
+        r.tempMin = std::min(r.tempMin, temp);
+        r.tempMax = std::max(r.tempMax, temp);
+    }
+    r.suprLamp  = rl.suprimidos;
+    r.suprMot   = rm.suprimidos;
+    r.energiaWh = (p.potLampada * r.segLamp + p.potMotor * r.segMot) / 3600.0f;
+    return r;
+}
@@ -0,0 +1,89 @@
+/*
+ * Simulador da estufa mais rápido que o tempo real.
+ *
+ * Roda o modelo de tools/planta.h com a mesma histérese e proteção
+ * dos relés do firmware (controle.h) e imprime, para cada
+ * conjunto de limiares, o número de acionamentos dos relés, quantas
+ * trocas a proteção segurou, o tempo fora da faixa de conforto e a energia.
+ * Um mês com passo de 1 s leva bem menos de um segundo.
+ *
+ * Compilar (na raiz do repositório):
+ *
+ *     g++ -O2 -std=c++17 tools/simular_estufa.cpp -o simular_estufa
+ *
+ * Uso:
+ *
+ *     ./simular_estufa [--dias N] [--passo S] [--semente N]
+ *                      [--clima arquivo.csv] [--faixa tMin,tMax,uMin,uMax]
+ *                      [--cfg tLig,tDes,uLig,uDes,luzLig,luzDes] ...
+ *
+ * --cfg pode ser repetido para comparar vários ajustes no mesmo clima;
+ * sem --cfg usa os padrões do firmware. Sem --clima gera um clima
+ * sintético com a mesma semente.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include "planta.h"
+
+static void uso() {
+    fprintf(stderr,
+        "uso: simular_estufa [--dias N] [--passo S] [--semente N] [--clima arq.csv]\n"
+        "                    [--faixa tMin,tMax,uMin,uMax] [--cfg tLig,tDes,uLig,uDes,luzLig,luzDes]...\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    Cenario cen;
+    ParamPlanta planta;
+    const char* arqClima = nullptr;
+    std::vector<Limiares> ajustes;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (i + 1 >= argc) uso();
+        const char* v = argv[++i];
+        if      (!strcmp(a, "--dias"))    cen.dias    = strtoul(v, nullptr, 10);
+        else if (!strcmp(a, "--passo"))   cen.passo   = strtoul(v, nullptr, 10);
+        else if (!strcmp(a, "--semente")) cen.semente = strtoul(v, nullptr, 10);
+        else if (!strcmp(a, "--clima"))   arqClima    = v;
+        else if (!strcmp(a, "--faixa")) {
+            if (sscanf(v, "%f,%f,%f,%f", &cen.tempMin, &cen.tempMax, &cen.umidMin, &cen.umidMax) != 4) uso();
+        } else if (!strcmp(a, "--cfg")) {
+            Limiares c;
+            if (sscanf(v, "%f,%f,%f,%f,%d,%d", &c.tempLigar, &c.tempDeslig, &c.umidLigar,
+                       &c.umidDeslig, &c.luzLigar, &c.luzDeslig) != 6) uso();
+            ajustes.push_back(c);
+        } else uso();
+    }
+    if (cen.dias == 0 || cen.passo == 0) uso();
+    if (ajustes.empty()) ajustes.push_back({ 30.0f, 27.0f, 70.0f, 60.0f, 25, 35 });   // padrões do firmware
+
+    TracoClima clima;
+    if (arqClima) {
+        if (!climaCsv(arqClima, clima)) { fprintf(stderr, "clima inválido: %s\n", arqClima); return 1; }
+    } else {
+        clima = climaSintetico(cen.dias, cen.semente);
+    }
+
+    printf("%u dias, passo %u s, faixa %.1f..%.1f °C / %.0f..%.0f %%\n\n",
+           cen.dias, cen.passo, cen.tempMin, cen.tempMax, cen.umidMin, cen.umidMax);
+    printf("%-28s %8s %8s %6s %6s %9s %9s %9s %7s %7s %6s\n",
+           "limiares (T/U/Luz)", "trocasL", "trocasM", "suprL", "suprM", "foraT(h)", "foraU(h)",
+           "energia", "Tmin", "Tmax", "ms");
+
+    for (const Limiares& c : ajustes) {
+        auto t0 = std::chrono::steady_clock::now();
+        ResultadoSim r = simular(c, planta, clima, cen);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - t0).count();
+
+        char rotulo[40];
+        snprintf(rotulo, sizeof(rotulo), "%.1f/%.1f %.0f/%.0f %d/%d",
+                 c.tempLigar, c.tempDeslig, c.umidLigar, c.umidDeslig, c.luzLigar, c.luzDeslig);
+        printf("%-28s %8u %8u %6u %6u %9.1f %9.1f %7.2fkWh %7.1f %7.1f %6lld\n",
+               rotulo, r.trocasLamp, r.trocasMot, r.suprLamp, r.suprMot, r.segForaTemp / 3600.0, r.segForaUmid / 3600.0,
+               r.energiaWh / 1000, r.tempMin, r.tempMax, (long long)ms);
+    }
+    return 0;
+}